@@ -61,6 +61,9 @@ namespace clang {
   class SelectorTable;
   class TargetInfo;
   class CXXABI;
+  class ASTMemoryAccounting;
+  class ConstexprCallCache;
+  class ConstexprInterpreter;
   class MangleNumberingContext;
   // Decls
   class MangleContext;
@@ -154,7 +157,8 @@ class ASTContext : public RefCountedBase<ASTContext> {
 
   /// \brief A cache mapping from RecordDecls to ASTRecordLayouts.
   ///
-  /// This is lazily created.  This is intentionally not serialized.
+  /// This is lazily created. The layouts of records from AST files may have
+  /// been stored in them; see ExternalASTSource::getStoredRecordLayout.
   mutable llvm::DenseMap<const RecordDecl*, const ASTRecordLayout*>
     ASTRecordLayouts;
   mutable llvm::DenseMap<const ObjCContainerDecl*, const ASTRecordLayout*>
@@ -451,9 +455,21 @@ private:
   /// AST objects will be released when the ASTContext itself is destroyed.
   mutable llvm::BumpPtrAllocator BumpAlloc;
 
+  /// \brief Attribution of the memory allocated for the AST, if enabled.
+  std::unique_ptr<ASTMemoryAccounting> MemoryAccounting;
+
+  /// \brief The bytecode interpreter for constexpr calls, created on first
+  /// use when enabled by -fconstexpr-bytecode.
+  mutable std::unique_ptr<ConstexprInterpreter> ConstexprInterp;
+
+  /// \brief The remembered results of constexpr function calls.
+  mutable std::unique_ptr<ConstexprCallCache> ConstexprCalls;
+
   /// \brief Allocator for partial diagnostics.
   PartialDiagnostic::StorageAllocator DiagAllocator;
 
+  void noteAllocation(const void *Ptr, size_t Size) const;
+
   /// \brief The current C++ ABI.
   std::unique_ptr<CXXABI> ABI;
   CXXABI *createCXXABI(const TargetInfo &T);
@@ -466,6 +482,7 @@ private:
   bool AddrSpaceMapMangling;
 
   friend class ASTDeclReader;
+  friend class ASTMemoryAccounting;
   friend class ASTReader;
   friend class ASTWriter;
   friend class CXXRecordDecl;
@@ -585,13 +602,33 @@ public:
   }
 
   void *Allocate(size_t Size, unsigned Align = 8) const {
-    return BumpAlloc.Allocate(Size, Align);
+    void *Ptr = BumpAlloc.Allocate(Size, Align);
+    if (LLVM_UNLIKELY(MemoryAccounting))
+      noteAllocation(Ptr, Size);
+    return Ptr;
   }
   template <typename T> T *Allocate(size_t Num = 1) const {
     return static_cast<T *>(Allocate(Num * sizeof(T), llvm::alignOf<T>()));
   }
   void Deallocate(void *Ptr) const { }
   
+  /// \brief Start attributing the memory allocated for the AST to node kinds,
+  /// files and template instantiations. This should be done before any AST
+  /// nodes are created.
+  void enableMemoryAccounting();
+
+  /// \brief Retrieve the attribution of the memory allocated for the AST, or
+  /// null if it is not enabled.
+  ASTMemoryAccounting *getMemoryAccounting() const {
+    return MemoryAccounting.get();
+  }
+
+  /// \brief Retrieve the bytecode interpreter for constexpr calls.
+  ConstexprInterpreter &getConstexprInterpreter() const;
+
+  /// \brief Retrieve the cache of constexpr function call results.
+  ConstexprCallCache &getConstexprCallCache() const;
+
   /// Return the total amount of physical memory allocated for representing
   /// AST nodes and type information.
   size_t getASTAllocatedMemory() const {
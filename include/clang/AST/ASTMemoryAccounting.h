@@ -0,0 +1,148 @@
+//===--- ASTMemoryAccounting.h - AST memory usage by category ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ASTMemoryAccounting class, which attributes the
+//  memory allocated by an ASTContext to node kinds, source files and
+//  template instantiations.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_ASTMEMORYACCOUNTING_H
+#define LLVM_CLANG_AST_ASTMEMORYACCOUNTING_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include <vector>
+
+namespace clang {
+
+class ASTContext;
+class Decl;
+
+/// \brief Keeps track of the memory allocated through an ASTContext, when
+/// enabled by \c ASTContext::enableMemoryAccounting().
+///
+/// Every allocation made through \c ASTContext::Allocate is recorded, and
+/// attributed to the innermost template instantiation in progress, if any.
+/// The addresses of declarations are remembered as they are allocated, so
+/// that their kinds and locations can be looked up when a summary is
+/// requested. Statements are found by walking the bodies, initializers and
+/// other expressions of those declarations at that point, and their sizes
+/// looked up among the recorded allocations. This costs 16 bytes per
+/// allocation and 16 more per declaration, which is why the accounting is
+/// opt-in.
+///
+/// Statements that are not reachable from a declaration, and those of
+/// declarations deserialized from an AST file (whose bodies are not loaded
+/// just to report on them), are only counted in the total.
+class ASTMemoryAccounting {
+public:
+  /// \brief The number of nodes (or allocations) in a category, and the
+  /// number of bytes allocated for them.
+  struct Usage {
+    uint64_t Bytes = 0;
+    unsigned Count = 0;
+
+    void add(uint64_t Size) {
+      Bytes += Size;
+      ++Count;
+    }
+  };
+
+  /// \brief A breakdown of the memory allocated by an ASTContext.
+  struct Summary {
+    /// \brief The bytes allocated through \c ASTContext::Allocate.
+    Usage Total;
+
+    /// \brief The bytes handed out by the ASTContext's allocator, including
+    /// allocations that bypassed \c ASTContext::Allocate.
+    uint64_t AllocatorBytes = 0;
+
+    /// \brief The memory reserved by the ASTContext's allocator.
+    uint64_t AllocatorCapacity = 0;
+
+    /// \brief Declarations, by kind.
+    llvm::StringMap<Usage> DeclKinds;
+
+    /// \brief Statements and expressions, by class.
+    llvm::StringMap<Usage> StmtClasses;
+
+    /// \brief Types, by class, including their trailing storage.
+    llvm::StringMap<Usage> TypeClasses;
+
+    /// \brief Declarations and statements, by the file containing (the
+    /// expansion location of) their location.
+    llvm::StringMap<Usage> Files;
+
+    /// \brief All allocations made while instantiating a template, by the
+    /// innermost entity being instantiated.
+    llvm::DenseMap<const Decl *, Usage> Instantiations;
+  };
+
+private:
+  struct NodeAllocation {
+    const void *Node;
+    uint64_t Size;
+  };
+
+  std::vector<NodeAllocation> Allocations;
+  std::vector<NodeAllocation> Decls;
+
+  Usage Total;
+  SmallVector<const Decl *, 8> InstantiationStack;
+  llvm::DenseMap<const Decl *, Usage> Instantiations;
+
+public:
+  ASTMemoryAccounting() = default;
+
+  ASTMemoryAccounting(const ASTMemoryAccounting &) = delete;
+  ASTMemoryAccounting &operator=(const ASTMemoryAccounting &) = delete;
+
+  /// \brief Note that \p Size bytes at \p Ptr were allocated through the
+  /// ASTContext.
+  void noteAllocation(const void *Ptr, uint64_t Size) {
+    Allocations.push_back({Ptr, Size});
+    Total.add(Size);
+    if (!InstantiationStack.empty())
+      Instantiations[InstantiationStack.back()].add(Size);
+  }
+
+  /// \brief Note that the storage for the given declaration, \p Size bytes
+  /// in total, has just been allocated. The declaration need not have been
+  /// constructed yet.
+  void noteDecl(const Decl *D, uint64_t Size) {
+    Decls.push_back({D, Size});
+  }
+
+  /// \brief Attribute subsequent allocations to the instantiation of the
+  /// given entity, until the matching call to \c popInstantiation.
+  void pushInstantiation(const Decl *Entity) {
+    InstantiationStack.push_back(Entity);
+  }
+
+  /// \brief Stop attributing allocations to the innermost instantiation.
+  void popInstantiation() {
+    assert(!InstantiationStack.empty() && "no instantiation in progress");
+    InstantiationStack.pop_back();
+  }
+
+  /// \brief Compute the memory usage of each category.
+  Summary summarize(const ASTContext &Context) const;
+
+  /// \brief Print the memory usage of the categories that use the most
+  /// memory.
+  void printReport(raw_ostream &OS, const ASTContext &Context,
+                   unsigned MaxEntries = 25) const;
+};
+
+} // end namespace clang
+
+#endif
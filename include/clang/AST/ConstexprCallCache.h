@@ -0,0 +1,110 @@
+//===--- ConstexprCallCache.h - Memoized constexpr calls --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ConstexprCallCache class, which remembers the
+//  results of constexpr function calls.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_CONSTEXPRCALLCACHE_H
+#define LLVM_CLANG_AST_CONSTEXPRCALLCACHE_H
+
+#include "clang/AST/APValue.h"
+#include "clang/AST/Decl.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/Support/Allocator.h"
+
+namespace clang {
+
+/// \brief The results of calls to constexpr functions, keyed by the function
+/// and the values of its arguments.
+///
+/// Only calls whose arguments are all integers (or enumerators) and whose
+/// results are integers or floating-point numbers are cached, since such a
+/// result cannot refer to any object whose value might change. Whether the
+/// evaluation of a call depended on anything else is up to the caller.
+class ConstexprCallCache {
+public:
+  /// \brief A remembered call.
+  struct Entry : llvm::FoldingSetNode {
+    llvm::FoldingSetNodeIDRef Key;
+    APValue Result;
+
+    /// \brief The number of evaluation steps the call took.
+    unsigned Steps;
+
+    /// \brief The depth of the most deeply nested call made by the call,
+    /// relative to the call itself.
+    unsigned Depth;
+
+    Entry(llvm::FoldingSetNodeIDRef Key, const APValue &Result,
+          unsigned Steps, unsigned Depth)
+        : Key(Key), Result(Result), Steps(Steps), Depth(Depth) {}
+
+    void Profile(llvm::FoldingSetNodeID &ID) const {
+      for (unsigned I = 0, N = Key.getSize(); I != N; ++I)
+        ID.AddInteger(Key.getData()[I]);
+    }
+  };
+
+private:
+  llvm::FoldingSet<Entry> Entries;
+  llvm::BumpPtrAllocator Allocator;
+
+public:
+  /// \brief The number of calls whose result was found in the cache.
+  unsigned NumHits = 0;
+
+  /// \brief The number of cacheable calls that had to be evaluated.
+  unsigned NumMisses = 0;
+
+  /// \brief Compute the key for a call to the given function with the given
+  /// arguments. Returns false if the call cannot be cached.
+  static bool getKey(const FunctionDecl *Callee, ArrayRef<APValue> Args,
+                     llvm::FoldingSetNodeID &ID) {
+    ID.AddPointer(Callee->getCanonicalDecl());
+    for (const APValue &Arg : Args) {
+      if (!Arg.isInt())
+        return false;
+      Arg.getInt().Profile(ID);
+    }
+    return true;
+  }
+
+  /// \brief Find a previous call with the given key, or null if there is
+  /// none.
+  const Entry *lookup(const llvm::FoldingSetNodeID &ID) {
+    void *InsertPos;
+    if (Entry *E = Entries.FindNodeOrInsertPos(ID, InsertPos)) {
+      ++NumHits;
+      return E;
+    }
+    ++NumMisses;
+    return nullptr;
+  }
+
+  /// \brief Record the result of a call with the given key, together with
+  /// the number of steps it took and the depth of the calls it made.
+  void insert(const llvm::FoldingSetNodeID &ID, const APValue &Result,
+              unsigned Steps, unsigned Depth) {
+    // Entries are never destroyed, so values that own memory are not kept.
+    if ((!Result.isInt() && !Result.isFloat()) || Result.needsCleanup())
+      return;
+    void *InsertPos;
+    if (Entries.FindNodeOrInsertPos(ID, InsertPos))
+      return;
+    Entries.InsertNode(new (Allocator) Entry(ID.Intern(Allocator), Result,
+                                             Steps, Depth),
+                       InsertPos);
+  }
+};
+
+} // end namespace clang
+
+#endif
@@ -0,0 +1,106 @@
+//===--- ConstexprInterpreter.h - Bytecode constexpr evaluation -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ConstexprInterpreter class, which evaluates calls to
+//  simple constexpr functions by compiling them to bytecode.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_CONSTEXPRINTERPRETER_H
+#define LLVM_CLANG_AST_CONSTEXPRINTERPRETER_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include <memory>
+
+namespace clang {
+
+class APValue;
+class ASTContext;
+class FunctionDecl;
+
+/// \brief Evaluates calls to constexpr functions by compiling their bodies,
+/// once, to bytecode for a small stack machine, and running that instead of
+/// walking the AST of the body on every call.
+///
+/// Only functions whose parameters, local variables and return value all
+/// have integral or enumeration type, and whose bodies are built from loops,
+/// conditionals, arithmetic and calls to other such functions, are compiled.
+/// Any call the interpreter cannot complete -- because the function uses
+/// some other construct, or because evaluation hits something that needs a
+/// diagnostic, such as overflow or the step limit -- is reported as not
+/// evaluated, and the caller falls back to the AST walker in
+/// ExprConstant.cpp, which then produces exactly the usual result and notes.
+class ConstexprInterpreter {
+public:
+  struct Function;
+
+private:
+  struct ExecutionState;
+
+  ASTContext &Ctx;
+
+  /// \brief The compiled form of each function definition we have tried to
+  /// compile; null if it could not be compiled.
+  llvm::DenseMap<const FunctionDecl *, std::unique_ptr<Function>> Functions;
+
+  unsigned NumFunctionsCompiled = 0;
+  unsigned NumFunctionsRejected = 0;
+  unsigned NumCallsEvaluated = 0;
+  unsigned NumCallsAttempted = 0;
+  unsigned NumCallsGivenUp = 0;
+
+  const Function *getFunction(const FunctionDecl *FD);
+  bool execute(const Function &F, const int64_t *Args, unsigned Depth,
+               ExecutionState &State, int64_t &Result);
+
+public:
+  explicit ConstexprInterpreter(ASTContext &Ctx);
+  ~ConstexprInterpreter();
+
+  /// \brief The outcome of offering a call to the interpreter.
+  enum CallResult {
+    /// The call was evaluated.
+    CR_Evaluated,
+
+    /// The function or its arguments are not supported by the interpreter.
+    CR_Unsupported,
+
+    /// The interpreter started evaluating the call but gave up, e.g. on
+    /// overflow or when it ran out of steps. Calls made by the AST walker
+    /// while it evaluates the same call again would most likely give up in
+    /// the same way, so they should not be offered to the interpreter.
+    CR_GaveUp
+  };
+
+  /// \brief Try to evaluate a call to the given constexpr function
+  /// definition with the given argument values.
+  ///
+  /// \param MaxDepth The number of nested calls the call may make before
+  /// the constexpr call depth limit is reached.
+  ///
+  /// \param StepsLeft The remaining number of evaluation steps; on success,
+  /// the steps taken by the call are subtracted from it.
+  ///
+  /// \param NestedDepth On success, set to the depth of the most deeply
+  /// nested call made by the call, or 0 if it made no calls.
+  ///
+  /// \returns CR_Evaluated, and sets \p Result, if the call was evaluated.
+  /// Otherwise the call must be evaluated by the AST walker.
+  CallResult evaluateCall(const FunctionDecl *Definition,
+                          ArrayRef<APValue> Args, unsigned MaxDepth,
+                          unsigned &StepsLeft, unsigned &NestedDepth,
+                          APValue &Result);
+
+  void PrintStats() const;
+};
+
+} // end namespace clang
+
+#endif
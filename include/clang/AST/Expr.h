@@ -2147,47 +2147,98 @@ public:
 /// "str1 + str2" to resolve to a function call.
 class CallExpr : public Expr {
   enum { FN=0, PREARGS_START=1 };
-  Stmt **SubExprs;
   unsigned NumArgs;
   SourceLocation RParenLoc;
+#ifndef NDEBUG
+  /// The number of arguments storage was allocated for, which
+  /// setNumArgsUnsafe must not exceed.
+  unsigned NumArgsCapacity;
+#endif
 
   void updateDependenciesFromArg(Expr *Arg);
 
+  // The callee, the pre-arguments and the arguments are stored in trailing
+  // storage, following the object of the most derived class. The offset to
+  // them is kept in CallExprBits, so that accessing them does not depend on
+  // the class of the call.
+
+  /// \brief Return the offset from the start of an object of the given
+  /// class to its sub-expressions.
+  static unsigned offsetToTrailingStmts(StmtClass SC);
+
+  Stmt **getTrailingStmts() {
+    return reinterpret_cast<Stmt **>(reinterpret_cast<char *>(this) +
+                                     CallExprBits.OffsetToTrailingStmts);
+  }
+  Stmt *const *getTrailingStmts() const {
+    return const_cast<CallExpr *>(this)->getTrailingStmts();
+  }
+
 protected:
-  // These versions of the constructor are for derived classes.
-  CallExpr(const ASTContext &C, StmtClass SC, Expr *fn,
-           ArrayRef<Expr *> preargs, ArrayRef<Expr *> args, QualType t,
-           ExprValueKind VK, SourceLocation rparenloc);
-  CallExpr(const ASTContext &C, StmtClass SC, Expr *fn, ArrayRef<Expr *> args,
-           QualType t, ExprValueKind VK, SourceLocation rparenloc);
-  CallExpr(const ASTContext &C, StmtClass SC, unsigned NumPreArgs,
+  /// \brief Return the number of bytes to allocate for a call expression of
+  /// the given class with storage for the given number of pre-arguments and
+  /// arguments.
+  static size_t sizeToAllocate(StmtClass SC, unsigned NumPreArgs,
+                               unsigned NumArgs) {
+    return offsetToTrailingStmts(SC) +
+           (PREARGS_START + NumPreArgs + NumArgs) * sizeof(Stmt *);
+  }
+
+  // These versions of the constructor are for derived classes, which are
+  // responsible for allocating storage for
+  // max(args.size(), MinNumArgs) arguments.
+  CallExpr(StmtClass SC, Expr *fn, ArrayRef<Expr *> preargs,
+           ArrayRef<Expr *> args, QualType t, ExprValueKind VK,
+           SourceLocation rparenloc, unsigned MinNumArgs = 0);
+  CallExpr(StmtClass SC, Expr *fn, ArrayRef<Expr *> args, QualType t,
+           ExprValueKind VK, SourceLocation rparenloc, unsigned MinNumArgs = 0);
+  CallExpr(StmtClass SC, unsigned NumPreArgs, unsigned NumArgs,
            EmptyShell Empty);
 
   Stmt *getPreArg(unsigned i) {
     assert(i < getNumPreArgs() && "Prearg access out of range!");
-    return SubExprs[PREARGS_START+i];
+    return getTrailingStmts()[PREARGS_START+i];
   }
   const Stmt *getPreArg(unsigned i) const {
     assert(i < getNumPreArgs() && "Prearg access out of range!");
-    return SubExprs[PREARGS_START+i];
+    return getTrailingStmts()[PREARGS_START+i];
   }
   void setPreArg(unsigned i, Stmt *PreArg) {
     assert(i < getNumPreArgs() && "Prearg access out of range!");
-    SubExprs[PREARGS_START+i] = PreArg;
+    getTrailingStmts()[PREARGS_START+i] = PreArg;
   }
 
   unsigned getNumPreArgs() const { return CallExprBits.NumPreArgs; }
 
 public:
-  CallExpr(const ASTContext& C, Expr *fn, ArrayRef<Expr*> args, QualType t,
-           ExprValueKind VK, SourceLocation rparenloc);
-
-  /// \brief Build an empty call expression.
-  CallExpr(const ASTContext &C, StmtClass SC, EmptyShell Empty);
-
-  const Expr *getCallee() const { return cast<Expr>(SubExprs[FN]); }
-  Expr *getCallee() { return cast<Expr>(SubExprs[FN]); }
-  void setCallee(Expr *F) { SubExprs[FN] = F; }
+  /// \brief Create a call expression.
+  ///
+  /// Storage is allocated for at least \p MinNumArgs arguments, so that
+  /// default arguments can later be added with setNumArgsUnsafe without
+  /// reallocating the call. The reserved arguments are null and are not
+  /// counted by getNumArgs until then.
+  static CallExpr *Create(const ASTContext &C, Expr *Fn,
+                          ArrayRef<Expr *> Args, QualType Ty,
+                          ExprValueKind VK, SourceLocation RParenLoc,
+                          unsigned MinNumArgs = 0);
+
+  /// \brief Create a call expression with no arguments in the given
+  /// memory, which must be at least sizeof(CallExpr) + sizeof(Stmt *) bytes
+  /// and suitably aligned. This is used to build short-lived calls on the
+  /// stack, e.g. to check whether a call would be well-formed.
+  static CallExpr *CreateTemporary(void *Mem, Expr *Fn, QualType Ty,
+                                   ExprValueKind VK,
+                                   SourceLocation RParenLoc);
+
+  /// \brief Create an empty call expression with storage for the given
+  /// number of arguments.
+  static CallExpr *CreateEmpty(const ASTContext &C, unsigned NumArgs);
+
+  const Expr *getCallee() const {
+    return cast<Expr>(getTrailingStmts()[FN]);
+  }
+  Expr *getCallee() { return cast<Expr>(getTrailingStmts()[FN]); }
+  void setCallee(Expr *F) { getTrailingStmts()[FN] = F; }
 
   Decl *getCalleeDecl();
   const Decl *getCalleeDecl() const {
@@ -2206,33 +2257,45 @@ public:
 
   /// \brief Retrieve the call arguments.
   Expr **getArgs() {
-    return reinterpret_cast<Expr **>(SubExprs+getNumPreArgs()+PREARGS_START);
+    return reinterpret_cast<Expr **>(getTrailingStmts() + getNumPreArgs() +
+                                     PREARGS_START);
   }
   const Expr *const *getArgs() const {
-    return reinterpret_cast<Expr **>(SubExprs + getNumPreArgs() +
-                                     PREARGS_START);
+    return const_cast<CallExpr *>(this)->getArgs();
   }
 
   /// getArg - Return the specified argument.
   Expr *getArg(unsigned Arg) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast_or_null<Expr>(SubExprs[Arg + getNumPreArgs() + PREARGS_START]);
+    return cast_or_null<Expr>(getArgs()[Arg]);
   }
   const Expr *getArg(unsigned Arg) const {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast_or_null<Expr>(SubExprs[Arg + getNumPreArgs() + PREARGS_START]);
+    return cast_or_null<Expr>(getArgs()[Arg]);
   }
 
   /// setArg - Set the specified argument.
   void setArg(unsigned Arg, Expr *ArgExpr) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    SubExprs[Arg+getNumPreArgs()+PREARGS_START] = ArgExpr;
+    getArgs()[Arg] = ArgExpr;
   }
 
-  /// setNumArgs - This changes the number of arguments present in this call.
-  /// Any orphaned expressions are deleted by this, and any new operands are set
-  /// to null.
-  void setNumArgs(const ASTContext& C, unsigned NumArgs);
+  /// \brief Reduce the number of arguments of this call, e.g. to drop
+  /// extra arguments during error recovery.
+  void shrinkNumArgs(unsigned NewNumArgs) {
+    assert(NewNumArgs <= NumArgs && "shrinkNumArgs cannot grow the call!");
+    NumArgs = NewNumArgs;
+  }
+
+  /// \brief Change the number of arguments of this call. The call must have
+  /// been created with storage for at least \p NewNumArgs arguments, e.g.
+  /// through the \p MinNumArgs argument of Create; the new arguments are
+  /// null until they are set.
+  void setNumArgsUnsafe(unsigned NewNumArgs) {
+    assert(NewNumArgs <= NumArgsCapacity &&
+           "setNumArgsUnsafe beyond the storage of the call!");
+    NumArgs = NewNumArgs;
+  }
 
   typedef ExprIterator arg_iterator;
   typedef ConstExprIterator const_arg_iterator;
@@ -2244,15 +2307,17 @@ public:
     return arg_const_range(arg_begin(), arg_end());
   }
 
-  arg_iterator arg_begin() { return SubExprs+PREARGS_START+getNumPreArgs(); }
+  arg_iterator arg_begin() {
+    return getTrailingStmts()+PREARGS_START+getNumPreArgs();
+  }
   arg_iterator arg_end() {
-    return SubExprs+PREARGS_START+getNumPreArgs()+getNumArgs();
+    return getTrailingStmts()+PREARGS_START+getNumPreArgs()+getNumArgs();
   }
   const_arg_iterator arg_begin() const {
-    return SubExprs+PREARGS_START+getNumPreArgs();
+    return getTrailingStmts()+PREARGS_START+getNumPreArgs();
   }
   const_arg_iterator arg_end() const {
-    return SubExprs+PREARGS_START+getNumPreArgs()+getNumArgs();
+    return getTrailingStmts()+PREARGS_START+getNumPreArgs()+getNumArgs();
   }
 
   /// This method provides fast access to all the subexpressions of
@@ -2260,7 +2325,7 @@ public:
   /// interface.  This provides efficient reverse iteration of the
   /// subexpressions.  This is currently used for CFG construction.
   ArrayRef<Stmt*> getRawSubExprs() {
-    return llvm::makeArrayRef(SubExprs,
+    return llvm::makeArrayRef(getTrailingStmts(),
                               getNumPreArgs() + PREARGS_START + getNumArgs());
   }
 
@@ -2294,8 +2359,8 @@ public:
 
   // Iterators
   child_range children() {
-    return child_range(&SubExprs[0],
-                       &SubExprs[0]+NumArgs+getNumPreArgs()+PREARGS_START);
+    return child_range(getTrailingStmts(), getTrailingStmts() + NumArgs +
+                                               getNumPreArgs() + PREARGS_START);
   }
 };
 
@@ -60,17 +60,32 @@ class CXXOperatorCallExpr : public CallExpr {
   unsigned FPContractable : 1;
 
   SourceRange getSourceRangeImpl() const LLVM_READONLY;
-public:
-  CXXOperatorCallExpr(ASTContext& C, OverloadedOperatorKind Op, Expr *fn,
+
+  CXXOperatorCallExpr(OverloadedOperatorKind Op, Expr *fn,
                       ArrayRef<Expr*> args, QualType t, ExprValueKind VK,
-                      SourceLocation operatorloc, bool fpContractable)
-    : CallExpr(C, CXXOperatorCallExprClass, fn, args, t, VK, operatorloc),
+                      SourceLocation operatorloc, bool fpContractable,
+                      unsigned MinNumArgs)
+    : CallExpr(CXXOperatorCallExprClass, fn, args, t, VK, operatorloc,
+               MinNumArgs),
       Operator(Op), FPContractable(fpContractable) {
     Range = getSourceRangeImpl();
   }
-  explicit CXXOperatorCallExpr(ASTContext& C, EmptyShell Empty) :
-    CallExpr(C, CXXOperatorCallExprClass, Empty) { }
+  CXXOperatorCallExpr(unsigned NumArgs, EmptyShell Empty)
+    : CallExpr(CXXOperatorCallExprClass, /*NumPreArgs=*/0, NumArgs, Empty) { }
 
+public:
+  static CXXOperatorCallExpr *Create(const ASTContext &C,
+                                     OverloadedOperatorKind Op, Expr *Fn,
+                                     ArrayRef<Expr *> Args, QualType Ty,
+                                     ExprValueKind VK,
+                                     SourceLocation OperatorLoc,
+                                     bool FPContractable,
+                                     unsigned MinNumArgs = 0);
+
+  /// \brief Create an empty operator call expression with storage for the
+  /// given number of arguments.
+  static CXXOperatorCallExpr *CreateEmpty(const ASTContext &C,
+                                          unsigned NumArgs);
 
   /// \brief Returns the kind of overloaded operator that this
   /// expression refers to.
@@ -129,13 +144,22 @@ public:
 /// arguments are the arguments within the parentheses (not including
 /// the object argument).
 class CXXMemberCallExpr : public CallExpr {
+  CXXMemberCallExpr(Expr *fn, ArrayRef<Expr*> args, QualType t,
+                    ExprValueKind VK, SourceLocation RP, unsigned MinNumArgs)
+    : CallExpr(CXXMemberCallExprClass, fn, args, t, VK, RP, MinNumArgs) {}
+
+  CXXMemberCallExpr(unsigned NumArgs, EmptyShell Empty)
+    : CallExpr(CXXMemberCallExprClass, /*NumPreArgs=*/0, NumArgs, Empty) { }
+
 public:
-  CXXMemberCallExpr(ASTContext &C, Expr *fn, ArrayRef<Expr*> args,
-                    QualType t, ExprValueKind VK, SourceLocation RP)
-    : CallExpr(C, CXXMemberCallExprClass, fn, args, t, VK, RP) {}
+  static CXXMemberCallExpr *Create(const ASTContext &C, Expr *Fn,
+                                   ArrayRef<Expr *> Args, QualType Ty,
+                                   ExprValueKind VK, SourceLocation RP,
+                                   unsigned MinNumArgs = 0);
 
-  CXXMemberCallExpr(ASTContext &C, EmptyShell Empty)
-    : CallExpr(C, CXXMemberCallExprClass, Empty) { }
+  /// \brief Create an empty member call expression with storage for the
+  /// given number of arguments.
+  static CXXMemberCallExpr *CreateEmpty(const ASTContext &C, unsigned NumArgs);
 
   /// \brief Retrieves the implicit object argument for the member call.
   ///
@@ -171,14 +195,26 @@ class CUDAKernelCallExpr : public CallExpr {
 private:
   enum { CONFIG, END_PREARG };
 
+  CUDAKernelCallExpr(Expr *fn, CallExpr *Config, ArrayRef<Expr*> args,
+                     QualType t, ExprValueKind VK, SourceLocation RP,
+                     unsigned MinNumArgs)
+      : CallExpr(CUDAKernelCallExprClass, fn, Config, args, t, VK, RP,
+                 MinNumArgs) {}
+
+  CUDAKernelCallExpr(unsigned NumArgs, EmptyShell Empty)
+    : CallExpr(CUDAKernelCallExprClass, END_PREARG, NumArgs, Empty) { }
+
 public:
-  CUDAKernelCallExpr(ASTContext &C, Expr *fn, CallExpr *Config,
-                     ArrayRef<Expr*> args, QualType t, ExprValueKind VK,
-                     SourceLocation RP)
-      : CallExpr(C, CUDAKernelCallExprClass, fn, Config, args, t, VK, RP) {}
+  static CUDAKernelCallExpr *Create(const ASTContext &C, Expr *Fn,
+                                    CallExpr *Config, ArrayRef<Expr *> Args,
+                                    QualType Ty, ExprValueKind VK,
+                                    SourceLocation RP,
+                                    unsigned MinNumArgs = 0);
 
-  CUDAKernelCallExpr(ASTContext &C, EmptyShell Empty)
-    : CallExpr(C, CUDAKernelCallExprClass, END_PREARG, Empty) { }
+  /// \brief Create an empty kernel call expression with storage for the
+  /// given number of arguments.
+  static CUDAKernelCallExpr *CreateEmpty(const ASTContext &C,
+                                         unsigned NumArgs);
 
   const CallExpr *getConfig() const {
     return cast_or_null<CallExpr>(getPreArg(CONFIG));
@@ -420,14 +456,24 @@ class UserDefinedLiteral : public CallExpr {
   /// \brief The location of a ud-suffix within the literal.
   SourceLocation UDSuffixLoc;
 
-public:
-  UserDefinedLiteral(const ASTContext &C, Expr *Fn, ArrayRef<Expr*> Args,
-                     QualType T, ExprValueKind VK, SourceLocation LitEndLoc,
+  UserDefinedLiteral(Expr *Fn, ArrayRef<Expr*> Args, QualType T,
+                     ExprValueKind VK, SourceLocation LitEndLoc,
                      SourceLocation SuffixLoc)
-    : CallExpr(C, UserDefinedLiteralClass, Fn, Args, T, VK, LitEndLoc),
+    : CallExpr(UserDefinedLiteralClass, Fn, Args, T, VK, LitEndLoc),
       UDSuffixLoc(SuffixLoc) {}
-  explicit UserDefinedLiteral(const ASTContext &C, EmptyShell Empty)
-    : CallExpr(C, UserDefinedLiteralClass, Empty) {}
+  UserDefinedLiteral(unsigned NumArgs, EmptyShell Empty)
+    : CallExpr(UserDefinedLiteralClass, /*NumPreArgs=*/0, NumArgs, Empty) {}
+
+public:
+  static UserDefinedLiteral *Create(const ASTContext &C, Expr *Fn,
+                                    ArrayRef<Expr *> Args, QualType Ty,
+                                    ExprValueKind VK, SourceLocation LitEndLoc,
+                                    SourceLocation SuffixLoc);
+
+  /// \brief Create an empty user-defined literal with storage for the given
+  /// number of arguments.
+  static UserDefinedLiteral *CreateEmpty(const ASTContext &C,
+                                         unsigned NumArgs);
 
   /// The kind of literal operator which is invoked.
   enum LiteralOperatorKind {
@@ -1183,19 +1229,27 @@ private:
 
   SourceLocation Loc;
   SourceRange ParenOrBraceRange;
-  unsigned NumArgs : 16;
-  unsigned Elidable : 1;
-  unsigned HadMultipleCandidates : 1;
-  unsigned ListInitialization : 1;
-  unsigned StdInitListInitialization : 1;
-  unsigned ZeroInitialization : 1;
-  unsigned ConstructKind : 2;
-  Stmt **Args;
+  unsigned NumArgs;
+
+  // The arguments are stored in trailing storage, following the object of
+  // the most derived class.
+
+  /// \brief Return the offset from the start of an object of the given
+  /// class to its arguments.
+  static unsigned offsetToTrailingArgs(StmtClass SC);
+
+  Stmt **getTrailingArgs() {
+    return reinterpret_cast<Stmt **>(reinterpret_cast<char *>(this) +
+                                     offsetToTrailingArgs(getStmtClass()));
+  }
+  Stmt *const *getTrailingArgs() const {
+    return const_cast<CXXConstructExpr *>(this)->getTrailingArgs();
+  }
 
   void setConstructor(CXXConstructorDecl *C) { Constructor = C; }
 
 protected:
-  CXXConstructExpr(const ASTContext &C, StmtClass SC, QualType T,
+  CXXConstructExpr(StmtClass SC, QualType T,
                    SourceLocation Loc,
                    CXXConstructorDecl *Ctor,
                    bool Elidable,
@@ -1208,16 +1262,12 @@ protected:
                    SourceRange ParenOrBraceRange);
 
   /// \brief Construct an empty C++ construction expression.
-  CXXConstructExpr(StmtClass SC, EmptyShell Empty)
-    : Expr(SC, Empty), Constructor(nullptr), NumArgs(0), Elidable(false),
-      HadMultipleCandidates(false), ListInitialization(false),
-      ZeroInitialization(false), ConstructKind(0), Args(nullptr)
-  { }
+  CXXConstructExpr(StmtClass SC, EmptyShell Empty, unsigned NumArgs);
 
 public:
-  /// \brief Construct an empty C++ construction expression.
-  explicit CXXConstructExpr(EmptyShell Empty)
-    : CXXConstructExpr(CXXConstructExprClass, Empty) {}
+  /// \brief Create an empty C++ construction expression with storage for
+  /// the given number of arguments.
+  static CXXConstructExpr *CreateEmpty(const ASTContext &C, unsigned NumArgs);
 
   static CXXConstructExpr *Create(const ASTContext &C, QualType T,
                                   SourceLocation Loc,
@@ -1238,39 +1288,53 @@ public:
   void setLocation(SourceLocation Loc) { this->Loc = Loc; }
 
   /// \brief Whether this construction is elidable.
-  bool isElidable() const { return Elidable; }
-  void setElidable(bool E) { Elidable = E; }
+  bool isElidable() const { return CXXConstructExprBits.Elidable; }
+  void setElidable(bool E) { CXXConstructExprBits.Elidable = E; }
 
   /// \brief Whether the referred constructor was resolved from
   /// an overloaded set having size greater than 1.
-  bool hadMultipleCandidates() const { return HadMultipleCandidates; }
-  void setHadMultipleCandidates(bool V) { HadMultipleCandidates = V; }
+  bool hadMultipleCandidates() const {
+    return CXXConstructExprBits.HadMultipleCandidates;
+  }
+  void setHadMultipleCandidates(bool V) {
+    CXXConstructExprBits.HadMultipleCandidates = V;
+  }
 
   /// \brief Whether this constructor call was written as list-initialization.
-  bool isListInitialization() const { return ListInitialization; }
-  void setListInitialization(bool V) { ListInitialization = V; }
+  bool isListInitialization() const {
+    return CXXConstructExprBits.ListInitialization;
+  }
+  void setListInitialization(bool V) {
+    CXXConstructExprBits.ListInitialization = V;
+  }
 
   /// \brief Whether this constructor call was written as list-initialization,
   /// but was interpreted as forming a std::initializer_list<T> from the list
   /// and passing that as a single constructor argument.
   /// See C++11 [over.match.list]p1 bullet 1.
-  bool isStdInitListInitialization() const { return StdInitListInitialization; }
-  void setStdInitListInitialization(bool V) { StdInitListInitialization = V; }
+  bool isStdInitListInitialization() const {
+    return CXXConstructExprBits.StdInitListInitialization;
+  }
+  void setStdInitListInitialization(bool V) {
+    CXXConstructExprBits.StdInitListInitialization = V;
+  }
 
   /// \brief Whether this construction first requires
   /// zero-initialization before the initializer is called.
-  bool requiresZeroInitialization() const { return ZeroInitialization; }
+  bool requiresZeroInitialization() const {
+    return CXXConstructExprBits.ZeroInitialization;
+  }
   void setRequiresZeroInitialization(bool ZeroInit) {
-    ZeroInitialization = ZeroInit;
+    CXXConstructExprBits.ZeroInitialization = ZeroInit;
   }
 
   /// \brief Determine whether this constructor is actually constructing
   /// a base class (rather than a complete object).
   ConstructionKind getConstructionKind() const {
-    return (ConstructionKind)ConstructKind;
+    return (ConstructionKind)CXXConstructExprBits.ConstructKind;
   }
   void setConstructionKind(ConstructionKind CK) {
-    ConstructKind = CK;
+    CXXConstructExprBits.ConstructKind = CK;
   }
 
   typedef ExprIterator arg_iterator;
@@ -1283,12 +1347,12 @@ public:
     return arg_const_range(arg_begin(), arg_end());
   }
 
-  arg_iterator arg_begin() { return Args; }
-  arg_iterator arg_end() { return Args + NumArgs; }
-  const_arg_iterator arg_begin() const { return Args; }
-  const_arg_iterator arg_end() const { return Args + NumArgs; }
+  arg_iterator arg_begin() { return getTrailingArgs(); }
+  arg_iterator arg_end() { return getTrailingArgs() + NumArgs; }
+  const_arg_iterator arg_begin() const { return getTrailingArgs(); }
+  const_arg_iterator arg_end() const { return getTrailingArgs() + NumArgs; }
 
-  Expr **getArgs() { return reinterpret_cast<Expr **>(Args); }
+  Expr **getArgs() { return reinterpret_cast<Expr **>(getTrailingArgs()); }
   const Expr *const *getArgs() const {
     return const_cast<CXXConstructExpr *>(this)->getArgs();
   }
@@ -1297,17 +1361,17 @@ public:
   /// \brief Return the specified argument.
   Expr *getArg(unsigned Arg) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast<Expr>(Args[Arg]);
+    return cast<Expr>(getTrailingArgs()[Arg]);
   }
   const Expr *getArg(unsigned Arg) const {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast<Expr>(Args[Arg]);
+    return cast<Expr>(getTrailingArgs()[Arg]);
   }
 
   /// \brief Set the specified argument.
   void setArg(unsigned Arg, Expr *ArgExpr) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    Args[Arg] = ArgExpr;
+    getTrailingArgs()[Arg] = ArgExpr;
   }
 
   SourceLocation getLocStart() const LLVM_READONLY;
@@ -1322,7 +1386,7 @@ public:
 
   // Iterators
   child_range children() {
-    return child_range(&Args[0], &Args[0]+NumArgs);
+    return child_range(getTrailingArgs(), getTrailingArgs() + NumArgs);
   }
 
   friend class ASTStmtReader;
@@ -1464,9 +1528,7 @@ public:
 class CXXTemporaryObjectExpr : public CXXConstructExpr {
   TypeSourceInfo *Type;
 
-public:
-  CXXTemporaryObjectExpr(const ASTContext &C,
-                         CXXConstructorDecl *Cons,
+  CXXTemporaryObjectExpr(CXXConstructorDecl *Cons,
                          TypeSourceInfo *Type,
                          ArrayRef<Expr *> Args,
                          SourceRange ParenOrBraceRange,
@@ -1474,8 +1536,25 @@ public:
                          bool ListInitialization,
                          bool StdInitListInitialization,
                          bool ZeroInitialization);
-  explicit CXXTemporaryObjectExpr(EmptyShell Empty)
-    : CXXConstructExpr(CXXTemporaryObjectExprClass, Empty), Type() { }
+  CXXTemporaryObjectExpr(EmptyShell Empty, unsigned NumArgs)
+    : CXXConstructExpr(CXXTemporaryObjectExprClass, Empty, NumArgs),
+      Type() { }
+
+public:
+  static CXXTemporaryObjectExpr *Create(const ASTContext &C,
+                                        CXXConstructorDecl *Cons,
+                                        TypeSourceInfo *Type,
+                                        ArrayRef<Expr *> Args,
+                                        SourceRange ParenOrBraceRange,
+                                        bool HadMultipleCandidates,
+                                        bool ListInitialization,
+                                        bool StdInitListInitialization,
+                                        bool ZeroInitialization);
+
+  /// \brief Create an empty temporary object expression with storage for
+  /// the given number of arguments.
+  static CXXTemporaryObjectExpr *CreateEmpty(const ASTContext &C,
+                                             unsigned NumArgs);
 
   TypeSourceInfo *getTypeSourceInfo() const { return Type; }
 
@@ -1489,6 +1568,12 @@ public:
   friend class ASTStmtReader;
 };
 
+inline unsigned CXXConstructExpr::offsetToTrailingArgs(StmtClass SC) {
+  if (SC == CXXTemporaryObjectExprClass)
+    return sizeof(CXXTemporaryObjectExpr);
+  return sizeof(CXXConstructExpr);
+}
+
 /// \brief A C++ lambda expression, which produces a function object
 /// (of unspecified type) that can be invoked later.
 ///
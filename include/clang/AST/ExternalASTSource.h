@@ -21,6 +21,7 @@
 namespace clang {
 
 class ASTConsumer;
+class ASTRecordLayout;
 class CXXBaseSpecifier;
 class CXXCtorInitializer;
 class DeclarationName;
@@ -275,6 +276,16 @@ public:
       llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
       llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets);
 
+  /// \brief Retrieve a layout of the given record definition that was
+  /// computed when the external source was built.
+  ///
+  /// Unlike \c layoutRecordType, the layout is used as it is, without
+  /// running the record layout builder at all.
+  ///
+  /// \returns the layout, allocated in the ASTContext, or null if the
+  /// external source has no layout for the record.
+  virtual const ASTRecordLayout *getStoredRecordLayout(const RecordDecl *Record);
+
   //===--------------------------------------------------------------------===//
   // Queries for performance analysis.
   //===--------------------------------------------------------------------===//
@@ -17,6 +17,7 @@
 #include "clang/AST/Type.h"
 #include "clang/Basic/ABI.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 
 namespace llvm {
@@ -57,6 +58,15 @@ private:
   llvm::DenseMap<const BlockDecl*, unsigned> LocalBlockIds;
   llvm::DenseMap<const TagDecl*, uint64_t> AnonStructIds;
 
+  /// The names remembered by the cached mangler entry points, keyed by the
+  /// canonical type and the kind of name.
+  llvm::DenseMap<std::pair<const void *, unsigned>, StringRef> CachedNames;
+  llvm::BumpPtrAllocator CachedNameAllocator;
+
+  StringRef cacheName(std::pair<const void *, unsigned> Key, StringRef Name);
+  StringRef getCachedTypeName(QualType T, unsigned Kind,
+                              SmallVectorImpl<char> &Buffer);
+
 public:
   ManglerKind getKind() const { return Kind; }
 
@@ -147,6 +157,23 @@ public:
   virtual void mangleTypeName(QualType T, raw_ostream &) = 0;
 
   /// @}
+
+  /// @name Cached Mangler Entry Points
+  ///
+  /// These produce the same names as the corresponding entry points above,
+  /// but remember the names of types whose mangling cannot change later on,
+  /// so that the RTTI, debug info, TBAA and type metadata clients that share
+  /// a MangleContext mangle each type only once. The returned name either
+  /// refers to the cache or to \p Buffer, which is cleared first.
+  ///
+  /// Declarations are not cached here: CodeGenModule already remembers the
+  /// mangled name of every declaration it emits.
+  /// @{
+
+  StringRef getMangledCXXRTTIName(QualType T, SmallVectorImpl<char> &Buffer);
+  StringRef getMangledTypeName(QualType T, SmallVectorImpl<char> &Buffer);
+
+  /// @}
 };
 
 class ItaniumMangleContext : public MangleContext {
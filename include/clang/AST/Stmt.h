@@ -191,6 +191,22 @@ protected:
     unsigned : NumExprBits;
 
     unsigned NumPreArgs : 1;
+
+    /// The offset in bytes from the start of the call to its callee and
+    /// arguments, which follow the object of the most derived class.
+    unsigned OffsetToTrailingStmts : 8;
+  };
+
+  class CXXConstructExprBitfields {
+    friend class CXXConstructExpr;
+    unsigned : NumExprBits;
+
+    unsigned Elidable : 1;
+    unsigned HadMultipleCandidates : 1;
+    unsigned ListInitialization : 1;
+    unsigned StdInitListInitialization : 1;
+    unsigned ZeroInitialization : 1;
+    unsigned ConstructKind : 2;
   };
 
   class ExprWithCleanupsBitfields {
@@ -263,6 +279,7 @@ protected:
     DeclRefExprBitfields DeclRefExprBits;
     CastExprBitfields CastExprBits;
     CallExprBitfields CallExprBits;
+    CXXConstructExprBitfields CXXConstructExprBits;
     ExprWithCleanupsBitfields ExprWithCleanupsBits;
     PseudoObjectExprBitfields PseudoObjectExprBits;
     ObjCIndirectCopyRestoreExprBitfields ObjCIndirectCopyRestoreExprBits;
@@ -143,6 +143,11 @@ public:
   /// in the backend for setting the name in the skeleton cu.
   std::string SplitDwarfFile;
 
+  /// The files to which the object code for the second and later partitions
+  /// of the module is written, with -fparallel-codegen=. The first partition
+  /// goes to the main output file.
+  std::vector<std::string> ParallelCodeGenOutputs;
+
   /// The name of the relocation model to use.
   std::string RelocationModel;
 
@@ -176,6 +181,11 @@ public:
   /// importing.
   std::string ThinLTOIndexFile;
 
+  /// Name of the file listing, for each vtable that would otherwise be
+  /// emitted as a discardable definition, the translation unit that defines
+  /// it (-fvtable-owners).
+  std::string VTableOwnersFile;
+
   /// A list of file names passed with -fcuda-include-gpubinary options to
   /// forward to CUDA runtime back-end for incorporating them into host-side
   /// object file.
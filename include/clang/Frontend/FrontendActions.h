@@ -70,10 +70,16 @@ protected:
 };
 
 class GeneratePCHAction : public ASTFrontendAction {
+  /// \brief Whether the existing output file was found to be up to date, so
+  /// that we only preprocess the input and don't write a new PCH file.
+  bool ReuseExistingPCH = false;
+
 protected:
   std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
                                                  StringRef InFile) override;
 
+  void ExecuteAction() override;
+
   TranslationUnitKind getTranslationUnitKind() override {
     return TU_Prefix;
   }
@@ -88,6 +94,12 @@ public:
   static std::unique_ptr<raw_pwrite_stream>
   ComputeASTConsumerArguments(CompilerInstance &CI, StringRef InFile,
                               std::string &Sysroot, std::string &OutputFile);
+
+  /// \brief Determine whether the PCH file \p OutputFile, produced by an
+  /// earlier run, is still up to date with respect to the main input file
+  /// \p InFile, the files it included and the current compiler options.
+  static bool isExistingPCHUpToDate(CompilerInstance &CI, StringRef InFile,
+                                    StringRef OutputFile);
 };
 
 class GenerateModuleAction : public ASTFrontendAction {
@@ -158,6 +158,19 @@ public:
                                            ///< files into the PCM file.
   unsigned IncludeTimestamps : 1;          ///< Whether timestamps should be
                                            ///< written to the produced PCH file.
+  unsigned TemplateProfile : 1;            ///< Whether to profile template
+                                           ///< instantiations.
+  unsigned ASTMemoryReport : 1;            ///< Whether to report the memory
+                                           ///< used by the AST, by category.
+  unsigned IncrementalPCH : 1;             ///< Whether an up-to-date output
+                                           ///< PCH file should be kept rather
+                                           ///< than regenerated.
+  unsigned CompressASTBlobs : 1;           ///< Whether large tables should be
+                                           ///< compressed in the produced PCH
+                                           ///< or module file.
+  unsigned StoreRecordLayouts : 1;         ///< Whether the layouts of records
+                                           ///< should be stored in the
+                                           ///< produced PCH or module file.
 
   CodeCompleteOptions CodeCompleteOpts;
 
@@ -276,6 +289,10 @@ public:
   /// Filename to write statistics to.
   std::string StatsFile;
 
+  /// Filename to write the template instantiation profile to, as folded
+  /// stacks.
+  std::string TemplateProfileOutput;
+
 public:
   FrontendOptions() :
     DisableFree(false), RelocatablePCH(false), ShowHelp(false),
@@ -285,7 +302,9 @@ public:
     SkipFunctionBodies(false), UseGlobalModuleIndex(true),
     GenerateGlobalModuleIndex(true), ASTDumpDecls(false), ASTDumpLookups(false),
     BuildingImplicitModule(false), ModulesEmbedAllFiles(false),
-    IncludeTimestamps(true), ARCMTAction(ARCMT_None),
+    IncludeTimestamps(true), TemplateProfile(false), ASTMemoryReport(false),
+    IncrementalPCH(false), CompressASTBlobs(false), StoreRecordLayouts(false),
+    ARCMTAction(ARCMT_None),
     ObjCMTAction(ObjCMT_None), ProgramAction(frontend::ParseSyntaxOnly)
   {}
 
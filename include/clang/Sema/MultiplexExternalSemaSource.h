@@ -183,6 +183,11 @@ public:
                  llvm::DenseMap<const CXXRecordDecl *,
                                 CharUnits> &VirtualBaseOffsets) override;
 
+  /// \brief Retrieve the layout of the given record that was computed when
+  /// one of the sources was built, if any.
+  const ASTRecordLayout *
+  getStoredRecordLayout(const RecordDecl *Record) override;
+
   /// Return the amount of memory used by memory buffers, breaking down
   /// by heap-backed versus mmap'ed memory.
   void getMemoryBufferSizes(MemoryBufferSizes &sizes) const override;
@@ -23,6 +23,7 @@
 #include "clang/AST/UnresolvedSet.h"
 #include "clang/Sema/SemaFixItUtils.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/AlignOf.h"
@@ -551,6 +552,54 @@ namespace clang {
     void dump() const;
   };
 
+  /// ConversionSequenceCache - Memoizes the implicit conversion sequences
+  /// computed for the arguments of overload candidates, keyed on the
+  /// argument's type and value kind, the parameter type, and the flags that
+  /// affect the conversion.
+  ///
+  /// The client is responsible for only caching conversions whose outcome
+  /// depends on nothing but the key, and cannot change later in the
+  /// translation unit.
+  class ConversionSequenceCache {
+    typedef std::pair<std::pair<void *, void *>, unsigned> KeyType;
+    llvm::DenseMap<KeyType, ImplicitConversionSequence> Conversions;
+
+    static KeyType getKey(QualType FromType, ExprValueKind VK,
+                          QualType ToType, unsigned Flags) {
+      return KeyType(std::make_pair(FromType.getAsOpaquePtr(),
+                                    ToType.getAsOpaquePtr()),
+                     (Flags << 2) | VK);
+    }
+
+  public:
+    /// The number of conversions that were found in the cache.
+    unsigned NumHits = 0;
+
+    /// The number of conversions that had to be computed.
+    unsigned NumMisses = 0;
+
+    /// Look up a previously-computed conversion sequence. Returns null if
+    /// there is none.
+    const ImplicitConversionSequence *lookup(QualType FromType,
+                                             ExprValueKind VK,
+                                             QualType ToType,
+                                             unsigned Flags) {
+      auto Known = Conversions.find(getKey(FromType, VK, ToType, Flags));
+      if (Known == Conversions.end()) {
+        ++NumMisses;
+        return nullptr;
+      }
+      ++NumHits;
+      return &Known->second;
+    }
+
+    /// Record a computed conversion sequence.
+    void insert(QualType FromType, ExprValueKind VK, QualType ToType,
+                unsigned Flags, const ImplicitConversionSequence &ICS) {
+      Conversions[getKey(FromType, VK, ToType, Flags)] = ICS;
+    }
+  };
+
   enum OverloadFailureKind {
     ovl_fail_too_many_arguments,
     ovl_fail_too_few_arguments,
@@ -100,11 +100,13 @@ namespace clang {
   class CodeCompletionAllocator;
   class CodeCompletionTUInfo;
   class CodeCompletionResult;
+  class ConversionSequenceCache;
   class Decl;
   class DeclAccessPair;
   class DeclContext;
   class DeclRefExpr;
   class DeclaratorDecl;
+  class DeducedSpecializationCache;
   class DeducedTemplateArgument;
   class DependentDiagnostic;
   class DesignatedInitExpr;
@@ -168,6 +170,7 @@ namespace clang {
   class TemplateArgumentList;
   class TemplateArgumentLoc;
   class TemplateDecl;
+  class TemplateInstantiationProfiler;
   class TemplateParameterList;
   class TemplatePartialOrderingContext;
   class TemplateTemplateParmDecl;
@@ -2485,6 +2488,10 @@ public:
   typedef llvm::SmallSetVector<DeclContext   *, 16> AssociatedNamespaceSet;
   typedef llvm::SmallSetVector<CXXRecordDecl *, 16> AssociatedClassSet;
 
+  /// \brief Implicit conversion sequences for the arguments of overload
+  /// candidates that have been computed so far, created on first use.
+  std::unique_ptr<ConversionSequenceCache> CandidateConversions;
+
   void AddOverloadCandidate(FunctionDecl *Function,
                             DeclAccessPair FoundDecl,
                             ArrayRef<Expr *> Args,
@@ -6563,6 +6570,10 @@ public:
            SmallVectorImpl<OriginalCallArg> const *OriginalCallArgs = nullptr,
                                   bool PartialOverloading = false);
 
+  /// \brief Function template specializations deduced from the arguments
+  /// of function calls so far, created on first use.
+  std::unique_ptr<DeducedSpecializationCache> DeducedSpecializations;
+
   TemplateDeductionResult
   DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
                           TemplateArgumentListInfo *ExplicitTemplateArgs,
@@ -6571,6 +6582,12 @@ public:
                           sema::TemplateDeductionInfo &Info,
                           bool PartialOverloading = false);
 
+  TemplateDeductionResult DeduceTemplateArgumentsFromCall(
+      FunctionTemplateDecl *FunctionTemplate,
+      TemplateArgumentListInfo *ExplicitTemplateArgs, ArrayRef<Expr *> Args,
+      FunctionDecl *&Specialization, sema::TemplateDeductionInfo &Info,
+      bool PartialOverloading);
+
   TemplateDeductionResult
   DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
                           TemplateArgumentListInfo *ExplicitTemplateArgs,
@@ -6816,6 +6833,19 @@ public:
   /// template defined within it.
   llvm::DenseSet<Module*> &getLookupModules();
 
+  /// \brief If template instantiation profiling is enabled, the profiler that
+  /// measures every entry in \c ActiveTemplateInstantiations.
+  std::unique_ptr<TemplateInstantiationProfiler> TemplateProfiler;
+
+  /// \brief Start measuring the cost of template instantiations.
+  void enableTemplateProfiling();
+
+  /// \brief Retrieve the template instantiation profiler, or null if
+  /// template instantiation profiling is not enabled.
+  TemplateInstantiationProfiler *getTemplateProfiler() const {
+    return TemplateProfiler.get();
+  }
+
   /// \brief Map from the most recent declaration of a namespace to the most
   /// recent visible declaration of that namespace.
   llvm::DenseMap<NamedDecl*, NamedDecl*> VisibleNamespaceCache;
@@ -7205,6 +7235,10 @@ public:
 
   void PerformPendingInstantiations(bool LocalOnly = false);
 
+  /// \brief Load the pending instantiations recorded by the external source,
+  /// if any, and perform them along with our own.
+  void PerformAllPendingInstantiations();
+
   TypeSourceInfo *SubstType(TypeSourceInfo *T,
                             const MultiLevelTemplateArgumentList &TemplateArgs,
                             SourceLocation Loc, DeclarationName Entity);
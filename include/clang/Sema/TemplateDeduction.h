@@ -15,7 +15,9 @@
 
 #include "clang/AST/DeclTemplate.h"
 #include "clang/Basic/PartialDiagnostic.h"
+#include "llvm/ADT/FoldingSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
 
 namespace clang {
 
@@ -315,6 +317,62 @@ public:
   }
 };
 
+/// \brief Remembers the function template specializations produced by
+/// successful template argument deduction for function calls, so that calls
+/// with the same template, explicit template arguments and argument types do
+/// not repeat the deduction.
+///
+/// Only successes are recorded: a failed deduction must be repeated so that
+/// the reason for the failure is available for diagnostics, and so that a
+/// deduction that failed because of declarations that were not yet visible
+/// is retried.
+class DeducedSpecializationCache {
+  struct Entry : llvm::FoldingSetNode {
+    llvm::FoldingSetNodeIDRef Key;
+    FunctionDecl *Specialization;
+
+    Entry(llvm::FoldingSetNodeIDRef Key, FunctionDecl *Specialization)
+        : Key(Key), Specialization(Specialization) {}
+
+    void Profile(llvm::FoldingSetNodeID &ID) const {
+      for (unsigned I = 0, N = Key.getSize(); I != N; ++I)
+        ID.AddInteger(Key.getData()[I]);
+    }
+  };
+
+  llvm::FoldingSet<Entry> Entries;
+  llvm::BumpPtrAllocator Allocator;
+
+public:
+  /// \brief The number of deductions whose result was found in the cache.
+  unsigned NumHits = 0;
+
+  /// \brief The number of cacheable deductions that had to be performed.
+  unsigned NumMisses = 0;
+
+  /// \brief Find the specialization previously deduced for the given key,
+  /// or null if there is none.
+  FunctionDecl *lookup(const llvm::FoldingSetNodeID &ID) {
+    void *InsertPos;
+    if (Entry *E = Entries.FindNodeOrInsertPos(ID, InsertPos)) {
+      ++NumHits;
+      return E->Specialization;
+    }
+    ++NumMisses;
+    return nullptr;
+  }
+
+  /// \brief Record the specialization deduced for the given key.
+  void insert(const llvm::FoldingSetNodeID &ID, FunctionDecl *Specialization) {
+    void *InsertPos;
+    if (Entries.FindNodeOrInsertPos(ID, InsertPos))
+      return;
+    Entries.InsertNode(new (Allocator) Entry(ID.Intern(Allocator),
+                                             Specialization),
+                       InsertPos);
+  }
+};
+
 } // end namespace clang
 
 #endif
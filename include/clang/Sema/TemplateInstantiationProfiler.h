@@ -0,0 +1,116 @@
+//===- TemplateInstantiationProfiler.h - Template cost profile --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the TemplateInstantiationProfiler class, which measures
+//  the cost of each template instantiation performed by Sema.
+//
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_CLANG_SEMA_TEMPLATEINSTANTIATIONPROFILER_H
+#define LLVM_CLANG_SEMA_TEMPLATEINSTANTIATIONPROFILER_H
+
+#include "clang/Sema/Sema.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace clang {
+
+/// \brief Records the wall time, the number of nested instantiations and the
+/// AST memory allocated by every entry pushed onto Sema's stack of active
+/// template instantiations (see \c Sema::InstantiatingTemplate).
+///
+/// The results can be printed as a report sorted by cost, aggregated both per
+/// specialization and per template, and as "folded stacks" suitable as input
+/// to flame graph tools.
+class TemplateInstantiationProfiler {
+public:
+  typedef Sema::ActiveTemplateInstantiation::InstantiationKind KindType;
+
+private:
+  /// \brief A specialization (or other entity) being instantiated, together
+  /// with the kind of work being done on it.
+  typedef std::pair<const Decl *, unsigned> KeyType;
+
+  /// \brief Accumulated cost of one key, or of one template.
+  struct Cost {
+    unsigned Count = 0;
+    unsigned Nested = 0;
+    double Time = 0;
+    double SelfTime = 0;
+    uint64_t Bytes = 0;
+  };
+
+  /// \brief A node in the tree of instantiation stacks, used to produce the
+  /// folded-stacks output.
+  struct StackNode {
+    KeyType Key;
+    unsigned Parent;
+    double SelfTime;
+    llvm::DenseMap<KeyType, unsigned> Children;
+  };
+
+  /// \brief An instantiation that is currently in progress.
+  struct Frame {
+    KeyType Key;
+    KeyType TemplateKey;
+    unsigned Node;
+    double StartTime;
+    double ChildTime;
+    uint64_t StartBytes;
+    unsigned StartCount;
+  };
+
+  ASTContext &Context;
+
+  llvm::DenseMap<KeyType, Cost> Specializations;
+  llvm::DenseMap<KeyType, Cost> Templates;
+
+  /// \brief How many times each key and each template appear on the stack of
+  /// frames, so that recursive instantiations are not counted twice.
+  llvm::DenseMap<KeyType, unsigned> KeysOnStack;
+  llvm::DenseMap<KeyType, unsigned> TemplatesOnStack;
+
+  std::vector<StackNode> Nodes;
+  SmallVector<Frame, 16> Stack;
+
+  /// \brief The total number of instantiations started so far.
+  unsigned NumInstantiations = 0;
+
+  /// \brief The total time spent in outermost instantiations.
+  double TotalTime = 0;
+
+  static KeyType getTemplateKey(KeyType Key);
+  std::string getName(KeyType Key, bool WithArgs) const;
+
+public:
+  explicit TemplateInstantiationProfiler(ASTContext &Context);
+
+  /// \brief Note that the given entry has been pushed onto the stack of
+  /// active template instantiations.
+  void startInstantiation(const Sema::ActiveTemplateInstantiation &Inst);
+
+  /// \brief Note that the innermost active template instantiation has
+  /// finished.
+  void finishInstantiation();
+
+  /// \brief Print the specializations and templates with the highest total
+  /// cost.
+  void printReport(llvm::raw_ostream &OS, unsigned MaxEntries = 25) const;
+
+  /// \brief Print the self time, in microseconds, of every distinct stack of
+  /// instantiations, one stack per line with frames separated by ';'.
+  void printFoldedStacks(llvm::raw_ostream &OS) const;
+};
+
+} // end namespace clang
+
+#endif
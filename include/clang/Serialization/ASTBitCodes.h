@@ -36,7 +36,7 @@ namespace clang {
     /// Version 4 of AST files also requires that the version control branch and
     /// revision match exactly, since there is no backward compatibility of
     /// AST files at this time.
-    const unsigned VERSION_MAJOR = 6;
+    const unsigned VERSION_MAJOR = 7;
 
     /// \brief AST file minor version number supported by this version of
     /// Clang.
@@ -580,7 +580,25 @@ namespace clang {
       MSSTRUCT_PRAGMA_OPTIONS = 55,
 
       /// \brief Record code for \#pragma ms_struct options.
-      POINTERS_TO_MEMBERS_PRAGMA_OPTIONS = 56
+      POINTERS_TO_MEMBERS_PRAGMA_OPTIONS = 56,
+
+      /// \brief Record code for the bloom filter over the names that this
+      /// module file's DeclContext lookup tables and method pool can answer
+      /// lookups for. Copied into the global module index.
+      LOOKUP_NAME_FILTER = 57,
+
+      /// \brief Record code for a zlib-compressed identifier table.
+      ///
+      /// [IDENTIFIER_TABLE_COMPRESSED, BucketOffset, UncompressedSize]
+      /// The blob decompresses to the blob of an IDENTIFIER_TABLE record.
+      IDENTIFIER_TABLE_COMPRESSED = 58,
+
+      /// \brief Record code for the layouts of the record definitions in this
+      /// AST file that were laid out when it was built.
+      ///
+      /// Each entry is [DeclID, Length, Data...], where Data is as written by
+      /// ASTWriter::AddRecordLayout.
+      RECORD_LAYOUTS = 59
     };
 
     /// \brief Record types used within a source manager block.
@@ -1181,6 +1199,11 @@ namespace clang {
       DECL_PRAGMA_DETECT_MISMATCH,
       /// \brief An OMPDeclareReductionDecl record.
       DECL_OMP_DECLARE_REDUCTION,
+      /// \brief A zlib-compressed DECL_CONTEXT_LEXICAL record.
+      ///
+      /// The record stores the size of the uncompressed data; the blob
+      /// decompresses to the blob of a DECL_CONTEXT_LEXICAL record.
+      DECL_CONTEXT_LEXICAL_COMPRESSED,
     };
 
     /// \brief Record codes for each kind of statement or expression.
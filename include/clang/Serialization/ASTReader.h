@@ -193,11 +193,14 @@ public:
   /// \brief if \c needsInputFileVisitation returns true, this is called for
   /// each non-system input file of the AST File. If
   /// \c needsSystemInputFileVisitation is true, then it is called for all
-  /// system input files as well.
+  /// system input files as well. \p StoredSize and \p StoredTime are the
+  /// size and modification time recorded for the file when the AST file was
+  /// written; \p StoredTime is zero if timestamps were not recorded.
   ///
   /// \returns true to continue receiving the next input file, false to stop.
   virtual bool visitInputFile(StringRef Filename, bool isSystem,
-                              bool isOverridden, bool isExplicitModule) {
+                              bool isOverridden, bool isExplicitModule,
+                              off_t StoredSize, time_t StoredTime) {
     return true;
   }
 
@@ -252,7 +255,8 @@ public:
   void visitModuleFile(StringRef Filename,
                        serialization::ModuleKind Kind) override;
   bool visitInputFile(StringRef Filename, bool isSystem,
-                      bool isOverridden, bool isExplicitModule) override;
+                      bool isOverridden, bool isExplicitModule,
+                      off_t StoredSize, time_t StoredTime) override;
   void readModuleFileExtension(
          const ModuleFileExtensionMetadata &Metadata) override;
 };
@@ -533,6 +537,7 @@ private:
   struct PendingVisibleUpdate {
     ModuleFile *Mod;
     const unsigned char *Data;
+    size_t Size;
   };
   typedef SmallVector<PendingVisibleUpdate, 1> DeclContextVisibleUpdates;
 
@@ -927,6 +932,9 @@ private:
   /// Number of visible decl contexts read/total.
   unsigned NumVisibleDeclContextsRead, TotalVisibleDeclContexts;
 
+  /// Number of stored record layouts read/total.
+  unsigned NumRecordLayoutsRead, TotalRecordLayouts;
+
   /// Total size of modules, in bits, currently loaded
   uint64_t TotalModulesSizeInBits;
 
@@ -1799,6 +1807,11 @@ public:
   /// \brief Print some statistics about AST usage.
   void PrintStats() override;
 
+  /// \brief Retrieve the layout of the given record definition that was
+  /// stored when its AST file was built, if any.
+  const ASTRecordLayout *
+  getStoredRecordLayout(const RecordDecl *Record) override;
+
   /// \brief Dump information about the AST reader to standard error.
   void dump();
 
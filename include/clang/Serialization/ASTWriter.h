@@ -127,6 +127,14 @@ private:
   /// file is up to date, but not otherwise.
   bool IncludeTimestamps;
 
+  /// \brief Whether to compress large blobs (identifier tables and lexical
+  /// declaration lists) in the AST file.
+  bool CompressBlobs;
+
+  /// \brief Whether to write the layouts computed for the record definitions
+  /// in the AST file.
+  bool StoreRecordLayouts;
+
   /// \brief Indicates when the AST writing is actively performing
   /// serialization, rather than just queueing updates.
   bool WritingAST;
@@ -293,6 +301,13 @@ private:
   /// table, indexed by the Selector ID (-1).
   std::vector<uint32_t> SelectorOffsets;
 
+  /// \brief The hashes of the names with entries in any DeclContext lookup
+  /// table or the method pool written to this module file.
+  ///
+  /// These are summarized in the LOOKUP_NAME_FILTER record, which lets the
+  /// global module index rule out module files without results for a name.
+  llvm::DenseSet<unsigned> LookupNameHashes;
+
   /// \brief Mapping from macro definitions (as they occur in the preprocessing
   /// record) to the macro IDs.
   llvm::DenseMap<const MacroDefinitionRecord *,
@@ -440,6 +455,8 @@ private:
   void WriteTypeAbbrevs();
   void WriteType(QualType T);
 
+  bool compressBlob(StringRef Blob, SmallVectorImpl<char> &Compressed);
+
   bool isLookupResultExternal(StoredDeclsList &Result, DeclContext *DC);
   bool isLookupResultEntirelyExternal(StoredDeclsList &Result, DeclContext *DC);
 
@@ -455,10 +472,13 @@ private:
   void WriteIdentifierTable(Preprocessor &PP, IdentifierResolver &IdResolver,
                             bool IsModule);
   void WriteDeclUpdatesBlocks(RecordDataImpl &OffsetsRecord);
+  bool AddRecordLayout(const ASTRecordLayout &Layout, RecordDataImpl &Record);
+  void WriteRecordLayouts(ASTContext &Context);
   void WriteDeclContextVisibleUpdate(const DeclContext *DC);
   void WriteFPPragmaOptions(const FPOptions &Opts);
   void WriteOpenCLExtensions(Sema &SemaRef);
   void WriteObjCCategories();
+  void WriteLookupNameFilter();
   void WriteLateParsedTemplates(Sema &SemaRef);
   void WriteOptimizePragmaOptions(Sema &SemaRef);
   void WriteMSStructPragmaOptions(Sema &SemaRef);
@@ -468,6 +488,7 @@ private:
 
   unsigned DeclParmVarAbbrev;
   unsigned DeclContextLexicalAbbrev;
+  unsigned DeclContextLexicalCompressedAbbrev;
   unsigned DeclContextVisibleLookupAbbrev;
   unsigned UpdateVisibleAbbrev;
   unsigned DeclRecordAbbrev;
@@ -495,7 +516,8 @@ public:
   /// the given bitstream.
   ASTWriter(llvm::BitstreamWriter &Stream,
             ArrayRef<llvm::IntrusiveRefCntPtr<ModuleFileExtension>> Extensions,
-            bool IncludeTimestamps = true);
+            bool IncludeTimestamps = true, bool CompressBlobs = false,
+            bool StoreRecordLayouts = false);
   ~ASTWriter() override;
 
   const LangOptions &getLangOpts() const;
@@ -616,6 +638,13 @@ public:
   /// within the identifier table.
   void SetIdentifierOffset(const IdentifierInfo *II, uint32_t Offset);
 
+  /// \brief Note that a lookup table or the method pool in this module file
+  /// contains an entry whose name has the given hash.
+  void AddLookupNameHash(unsigned Hash) {
+    if (WritingModule)
+      LookupNameHashes.insert(Hash);
+  }
+
   /// \brief Note that the selector Sel occurs at the given offset
   /// within the method pool/selector table.
   void SetSelectorOffset(Selector Sel, uint32_t Offset);
@@ -928,7 +957,9 @@ public:
     std::shared_ptr<PCHBuffer> Buffer,
     ArrayRef<llvm::IntrusiveRefCntPtr<ModuleFileExtension>> Extensions,
     bool AllowASTWithErrors = false,
-    bool IncludeTimestamps = true);
+    bool IncludeTimestamps = true,
+    bool CompressBlobs = false,
+    bool StoreRecordLayouts = false);
   ~PCHGenerator() override;
   void InitializeSema(Sema &S) override { SemaPtr = &S; }
   void HandleTranslationUnit(ASTContext &Ctx) override;
@@ -9,8 +9,10 @@
 //
 // This file defines the GlobalModuleIndex class, which manages a global index
 // containing all of the identifiers known to the various modules within a given
-// subdirectory of the module cache. It is used to improve the performance of
-// queries such as "do any modules know about this identifier?"
+// subdirectory of the module cache, along with a summary of the declaration
+// and selector names each module can answer lookups for. It is used to improve
+// the performance of queries such as "do any modules know about this
+// identifier?"
 //
 //===----------------------------------------------------------------------===//
 #ifndef LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
@@ -90,6 +92,11 @@ class GlobalModuleIndex {
     /// \brief The module IDs on which this module directly depends.
     /// FIXME: We don't really need a vector here.
     llvm::SmallVector<unsigned, 4> Dependencies;
+
+    /// \brief The bloom filter over the names for which this module file has
+    /// DeclContext lookup table or method pool entries, pointing into the
+    /// index buffer. Empty if the module file did not provide one.
+    StringRef NameFilter;
   };
 
   /// \brief A mapping from module IDs to information about each module.
@@ -115,6 +122,16 @@ class GlobalModuleIndex {
   /// \brief The number of identifier lookup hits, where we recognize the
   /// identifier.
   unsigned NumIdentifierLookupHits;
+
+  /// \brief The number of times we checked a module file's name filter.
+  unsigned NumNameFilterChecks;
+
+  /// \brief The number of name filter checks that ruled out the module file.
+  unsigned NumNameFilterRejections;
+
+  /// \brief Determine whether the module with the given ID may have lookup
+  /// results for a name with the given hash.
+  bool moduleMayContainName(unsigned ID, unsigned NameHash);
   
   /// \brief Internal constructor. Use \c readIndex() to read an index.
   explicit GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
@@ -179,6 +196,26 @@ public:
   /// \returns true if the identifier is known to the index, false otherwise.
   bool lookupIdentifier(StringRef Name, HitSet &Hits);
 
+  /// \brief Look for all of the module files which may have DeclContext
+  /// lookup results or Objective-C methods for the given name.
+  ///
+  /// \param NameHash The hash of the name, as computed by
+  /// \c serialization::DeclarationNameKey::getHash().
+  ///
+  /// \param Hits Will be populated with the set of module files that might
+  /// have information about this name. Module files that did not record a
+  /// name filter are always included.
+  ///
+  /// \returns true if the index could answer the query, false otherwise.
+  bool lookupName(unsigned NameHash, HitSet &Hits);
+
+  /// \brief Determine whether the given module file may have DeclContext
+  /// lookup results or Objective-C methods for the given name.
+  ///
+  /// \returns false only if the index proves that \p File has no information
+  /// about this name; module files unknown to the index always return true.
+  bool mayContainName(ModuleFile *File, unsigned NameHash);
+
   /// \brief Note that the given module file has been loaded.
   ///
   /// \returns false if the global module index has information about this
@@ -165,7 +165,21 @@ public:
   
   /// \brief The memory buffer that stores the data associated with
   /// this AST file.
-  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  ///
+  /// Buffers of AST files on disk are shared through the ModuleBufferCache
+  /// with other module managers that load the same file.
+  std::shared_ptr<llvm::MemoryBuffer> Buffer;
+
+  /// \brief Buffers holding the contents of compressed blobs from this AST
+  /// file that have been decompressed on demand.
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> DecompressedBlobs;
+
+  /// \brief The contents of the RECORD_LAYOUTS record of this AST file.
+  std::vector<uint64_t> RecordLayoutData;
+
+  /// \brief The position in RecordLayoutData of the stored layout of each
+  /// record definition, by global declaration ID.
+  llvm::DenseMap<serialization::DeclID, unsigned> RecordLayoutOffsets;
 
   /// \brief The size of this file, in bits.
   uint64_t SizeInBits;
@@ -0,0 +1,89 @@
+//===--- ModuleBufferCache.h - Process-wide AST file buffers ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ModuleBufferCache class, which lets every
+//  ModuleManager in the process share the memory buffers of the AST files
+//  they load.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SERIALIZATION_MODULEBUFFERCACHE_H
+#define LLVM_CLANG_SERIALIZATION_MODULEBUFFERCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Mutex.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace llvm {
+class MemoryBuffer;
+}
+
+namespace clang {
+
+class FileEntry;
+
+namespace serialization {
+
+/// \brief A thread-safe cache of the contents of AST files on disk, shared by
+/// all of the ModuleManagers in the process.
+///
+/// Tools that run many compilations over the same modular code base, possibly
+/// on several threads at once, would otherwise read each PCM file into memory
+/// once per compilation. Buffers are identified by the file's unique ID, size
+/// and modification time, so a module file that is rebuilt on disk is never
+/// confused with its previous contents.
+///
+/// The cache only holds weak references: a buffer stays in memory as long as
+/// at least one loaded module file refers to it.
+class ModuleBufferCache {
+  typedef std::tuple<llvm::sys::fs::UniqueID, off_t, time_t> KeyType;
+
+  llvm::sys::SmartMutex<true> Lock;
+  std::map<KeyType, std::weak_ptr<llvm::MemoryBuffer>> Buffers;
+
+  std::atomic<unsigned> NumHits;
+  std::atomic<unsigned> NumMisses;
+
+  static KeyType getKey(const FileEntry *File);
+
+  ModuleBufferCache() : NumHits(0), NumMisses(0) {}
+  ModuleBufferCache(const ModuleBufferCache &) = delete;
+  void operator=(const ModuleBufferCache &) = delete;
+
+public:
+  /// \brief Retrieve the cache shared by the whole process.
+  static ModuleBufferCache &getGlobal();
+
+  /// \brief Find a buffer holding the current contents of the given file, if
+  /// some other module file still has it loaded.
+  std::shared_ptr<llvm::MemoryBuffer> lookup(const FileEntry *File);
+
+  /// \brief Record the freshly-loaded contents of the given file.
+  ///
+  /// \returns the buffer that should be used for this file. If another thread
+  /// loaded the same file in the meantime, that buffer is returned and
+  /// \p Buffer is discarded.
+  std::shared_ptr<llvm::MemoryBuffer>
+  insert(const FileEntry *File, std::unique_ptr<llvm::MemoryBuffer> Buffer);
+
+  /// \brief The number of loads that were satisfied from the cache.
+  unsigned getNumHits() const { return NumHits; }
+
+  /// \brief The number of loads that had to read the file.
+  unsigned getNumMisses() const { return NumMisses; }
+};
+
+} // end namespace serialization
+} // end namespace clang
+
+#endif
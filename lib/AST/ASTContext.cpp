@@ -13,11 +13,14 @@
 
 #include "clang/AST/ASTContext.h"
 #include "CXXABI.h"
+#include "clang/AST/ASTMemoryAccounting.h"
 #include "clang/AST/ASTMutationListener.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/CharUnits.h"
 #include "clang/AST/Comment.h"
 #include "clang/AST/CommentCommandTraits.h"
+#include "clang/AST/ConstexprCallCache.h"
+#include "clang/AST/ConstexprInterpreter.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclContextInternals.h"
 #include "clang/AST/DeclObjC.h"
@@ -876,6 +879,33 @@ void ASTContext::PrintStats() const {
                << NumImplicitDestructors
                << " implicit destructors created\n";
 
+  // DeclContext lookup tables.
+  unsigned NumLookupTables = 0, NumLookupEntries = 0, NumMultiDeclEntries = 0;
+  size_t LookupBytes = 0;
+  for (StoredDeclsMap *Map = LastSDM.getPointer(); Map;
+       Map = Map->Previous.getPointer()) {
+    ++NumLookupTables;
+    NumLookupEntries += Map->size();
+    LookupBytes += sizeof(*Map) + Map->getMemorySize();
+    for (auto &Entry : *Map) {
+      if (StoredDeclsList::DeclsTy *Vec = Entry.second.getAsVector()) {
+        ++NumMultiDeclEntries;
+        LookupBytes += sizeof(*Vec) + llvm::capacity_in_bytes(*Vec);
+      }
+    }
+  }
+  llvm::errs() << NumLookupTables << " decl context lookup tables, "
+               << NumLookupEntries << " entries (" << NumMultiDeclEntries
+               << " with several declarations), " << LookupBytes
+               << " bytes\n";
+
+  if (ConstexprCalls)
+    llvm::errs() << ConstexprCalls->NumHits << "/"
+                 << (ConstexprCalls->NumHits + ConstexprCalls->NumMisses)
+                 << " cacheable constexpr calls found in the cache\n";
+  if (ConstexprInterp)
+    ConstexprInterp->PrintStats();
+
   if (ExternalSource) {
     llvm::errs() << "\n";
     ExternalSource->PrintStats();
@@ -884,6 +914,28 @@ void ASTContext::PrintStats() const {
   BumpAlloc.PrintStats();
 }
 
+void ASTContext::enableMemoryAccounting() {
+  if (!MemoryAccounting)
+    MemoryAccounting.reset(new ASTMemoryAccounting());
+}
+
+void ASTContext::noteAllocation(const void *Ptr, size_t Size) const {
+  MemoryAccounting->noteAllocation(Ptr, Size);
+}
+
+ConstexprInterpreter &ASTContext::getConstexprInterpreter() const {
+  if (!ConstexprInterp)
+    ConstexprInterp.reset(
+        new ConstexprInterpreter(const_cast<ASTContext &>(*this)));
+  return *ConstexprInterp;
+}
+
+ConstexprCallCache &ASTContext::getConstexprCallCache() const {
+  if (!ConstexprCalls)
+    ConstexprCalls.reset(new ConstexprCallCache());
+  return *ConstexprCalls;
+}
+
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
                                            bool NotifyListeners) {
   if (NotifyListeners)
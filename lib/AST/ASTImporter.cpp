@@ -6258,7 +6258,7 @@ Expr *ASTNodeImporter::VisitCXXTemporaryObjectExpr(CXXTemporaryObjectExpr *CE) {
   if (!Ctor)
     return nullptr;
 
-  return CXXTemporaryObjectExpr::Create(
+  return CXXConstructExpr::Create(
         Importer.getToContext(), T,
         Importer.Import(CE->getLocStart()),
         Ctor,
@@ -6418,9 +6418,9 @@ Expr *ASTNodeImporter::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
   if (ImportContainerChecked(E->arguments(), ToArgs))
     return nullptr;
 
-  return new (Importer.getToContext()) CXXMemberCallExpr(
-        Importer.getToContext(), ToFn, ToArgs, T, E->getValueKind(),
-        Importer.Import(E->getRParenLoc()));
+  return CXXMemberCallExpr::Create(
+      Importer.getToContext(), ToFn, ToArgs, T, E->getValueKind(),
+      Importer.Import(E->getRParenLoc()));
 }
 
 Expr *ASTNodeImporter::VisitCXXThisExpr(CXXThisExpr *E) {
@@ -6504,10 +6504,10 @@ Expr *ASTNodeImporter::VisitCallExpr(CallExpr *E) {
   for (unsigned ai = 0, ae = NumArgs; ai != ae; ++ai)
     ToArgs_Copied[ai] = ToArgs[ai];
 
-  return new (Importer.getToContext())
-    CallExpr(Importer.getToContext(), ToCallee, 
-             llvm::makeArrayRef(ToArgs_Copied, NumArgs), T, E->getValueKind(),
-             Importer.Import(E->getRParenLoc()));
+  return CallExpr::Create(Importer.getToContext(), ToCallee,
+                          llvm::makeArrayRef(ToArgs_Copied, NumArgs), T,
+                          E->getValueKind(),
+                          Importer.Import(E->getRParenLoc()));
 }
 
 Expr *ASTNodeImporter::VisitInitListExpr(InitListExpr *ILE) {
@@ -0,0 +1,192 @@
+//===--- ASTMemoryAccounting.cpp - AST memory usage by category -----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the ASTMemoryAccounting class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTMemoryAccounting.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/AST/Stmt.h"
+#include "clang/AST/Type.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace clang;
+
+static unsigned getTypeNodeSize(Type::TypeClass TC) {
+  switch (TC) {
+#define TYPE(Class, Base)                                                      \
+  case Type::Class:                                                            \
+    return sizeof(Class##Type);
+#define ABSTRACT_TYPE(Class, Base)
+#include "clang/AST/TypeNodes.def"
+  }
+  llvm_unreachable("unknown type class");
+}
+
+namespace {
+/// \brief Collects the statements owned by a single declaration, without
+/// descending into the declarations nested within it, which are visited as
+/// roots of their own.
+class OwnedStmtCollector : public RecursiveASTVisitor<OwnedStmtCollector> {
+  typedef RecursiveASTVisitor<OwnedStmtCollector> Base;
+
+  const Decl *Root = nullptr;
+  llvm::DenseSet<const Stmt *> &Stmts;
+
+public:
+  explicit OwnedStmtCollector(llvm::DenseSet<const Stmt *> &Stmts)
+      : Stmts(Stmts) {}
+
+  bool shouldVisitImplicitCode() const { return true; }
+
+  void collect(Decl *D) {
+    Root = D;
+    TraverseDecl(D);
+  }
+
+  bool TraverseDecl(Decl *D) {
+    if (D != Root)
+      return true;
+    return Base::TraverseDecl(D);
+  }
+
+  bool VisitStmt(Stmt *S) {
+    Stmts.insert(S);
+    return true;
+  }
+};
+} // end anonymous namespace
+
+static StringRef getFileName(const SourceManager &SM, SourceLocation Loc) {
+  if (Loc.isInvalid())
+    return "<no location>";
+  return SM.getBufferName(SM.getExpansionLoc(Loc));
+}
+
+ASTMemoryAccounting::Summary
+ASTMemoryAccounting::summarize(const ASTContext &Context) const {
+  Summary Result;
+  Result.Total = Total;
+  Result.AllocatorBytes = Context.getAllocator().getBytesAllocated();
+  Result.AllocatorCapacity = Context.getAllocator().getTotalMemory();
+  Result.Instantiations = Instantiations;
+
+  llvm::DenseMap<const void *, uint64_t> AllocationSizes;
+  AllocationSizes.reserve(Allocations.size());
+  for (const NodeAllocation &Alloc : Allocations)
+    AllocationSizes[Alloc.Node] = Alloc.Size;
+
+  const SourceManager &SM = Context.getSourceManager();
+  llvm::DenseSet<const Stmt *> Stmts;
+  OwnedStmtCollector Collector(Stmts);
+  for (const NodeAllocation &Alloc : Decls) {
+    const Decl *D = static_cast<const Decl *>(Alloc.Node);
+    Result.DeclKinds[D->getDeclKindName()].add(Alloc.Size);
+    Result.Files[getFileName(SM, D->getLocation())].add(Alloc.Size);
+  }
+
+  // Walking a declaration must not deserialize anything: that would allocate
+  // (and note) new declarations while we iterate over them.
+  for (const NodeAllocation &Alloc : Decls) {
+    Decl *D = const_cast<Decl *>(static_cast<const Decl *>(Alloc.Node));
+    if (D->isFromASTFile())
+      continue;
+    if (auto *DC = dyn_cast<DeclContext>(D))
+      if (DC->hasExternalLexicalStorage())
+        continue;
+    Collector.collect(D);
+  }
+  for (const Stmt *S : Stmts) {
+    // Statements of another ASTContext, such as those of an imported
+    // declaration's original, were never allocated here.
+    auto Known = AllocationSizes.find(S);
+    if (Known == AllocationSizes.end())
+      continue;
+    Result.StmtClasses[S->getStmtClassName()].add(Known->second);
+    Result.Files[getFileName(SM, S->getLocStart())].add(Known->second);
+  }
+  for (const Type *T : Context.Types) {
+    auto Known = AllocationSizes.find(T);
+    Result.TypeClasses[T->getTypeClassName()].add(
+        Known != AllocationSizes.end() ? Known->second
+                                       : getTypeNodeSize(T->getTypeClass()));
+  }
+
+  return Result;
+}
+
+typedef std::pair<std::string, ASTMemoryAccounting::Usage> ReportEntry;
+
+static void printTable(raw_ostream &OS, StringRef Title,
+                       std::vector<ReportEntry> &Entries, unsigned MaxEntries) {
+  std::sort(Entries.begin(), Entries.end(),
+            [](const ReportEntry &X, const ReportEntry &Y) {
+              return X.second.Bytes > Y.second.Bytes;
+            });
+
+  uint64_t TotalBytes = 0;
+  for (const ReportEntry &E : Entries)
+    TotalBytes += E.second.Bytes;
+
+  size_t NumShown = std::min<size_t>(Entries.size(), MaxEntries);
+  OS << "  " << Title << " (top " << NumShown << " of " << Entries.size()
+     << ", " << TotalBytes << " bytes):\n";
+  OS << "         Bytes      Count  Name\n";
+  for (size_t I = 0; I != NumShown; ++I)
+    OS << llvm::format("  %12llu %10u  ",
+                       (unsigned long long)Entries[I].second.Bytes,
+                       Entries[I].second.Count)
+       << Entries[I].first << '\n';
+}
+
+static void printTable(raw_ostream &OS, StringRef Title,
+                       const llvm::StringMap<ASTMemoryAccounting::Usage> &Map,
+                       unsigned MaxEntries) {
+  std::vector<ReportEntry> Entries;
+  for (const auto &E : Map)
+    Entries.push_back(ReportEntry(E.getKey(), E.getValue()));
+  printTable(OS, Title, Entries, MaxEntries);
+}
+
+void ASTMemoryAccounting::printReport(raw_ostream &OS,
+                                      const ASTContext &Context,
+                                      unsigned MaxEntries) const {
+  Summary S = summarize(Context);
+
+  OS << "\n*** AST Memory Report:\n";
+  OS << "  " << S.Total.Bytes << " bytes in " << S.Total.Count
+     << " allocations through the ASTContext\n";
+  OS << "  " << S.AllocatorBytes << " bytes allocated, "
+     << S.AllocatorCapacity << " bytes reserved by the AST allocator\n";
+
+  printTable(OS, "Declarations", S.DeclKinds, MaxEntries);
+  printTable(OS, "Statements", S.StmtClasses, MaxEntries);
+  printTable(OS, "Types", S.TypeClasses, MaxEntries);
+  printTable(OS, "Files", S.Files, MaxEntries);
+
+  std::vector<ReportEntry> Entries;
+  for (const auto &E : S.Instantiations) {
+    std::string Name;
+    llvm::raw_string_ostream NameOS(Name);
+    if (auto *ND = dyn_cast<NamedDecl>(E.first))
+      ND->getNameForDiagnostic(NameOS, Context.getPrintingPolicy(),
+                               /*Qualified=*/true);
+    else
+      NameOS << E.first->getDeclKindName();
+    Entries.push_back(ReportEntry(NameOS.str(), E.second));
+  }
+  printTable(OS, "Template instantiations", Entries, MaxEntries);
+}
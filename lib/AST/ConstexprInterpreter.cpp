@@ -0,0 +1,1104 @@
+//===--- ConstexprInterpreter.cpp - Bytecode constexpr evaluation ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the ConstexprInterpreter class.
+//
+//  Values are held in 64-bit words. A value of a signed type is kept sign
+//  extended from the width of its type, and a value of an unsigned type is
+//  kept zero extended, so that comparisons and bitwise operations can work
+//  on the words directly. Each instruction is an opcode word followed by its
+//  operand words. Type operands encode the width of the type and whether it
+//  is signed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ConstexprInterpreter.h"
+#include "clang/AST/APValue.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/StmtCXX.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <vector>
+
+using namespace clang;
+
+namespace {
+enum Opcode : int64_t {
+  OP_Const,       // value
+  OP_GetLocal,    // slot
+  OP_SetLocal,    // slot
+  OP_Pop,
+  OP_Dup,
+  OP_Convert,     // type
+  OP_ToBool,
+  OP_Add,         // type
+  OP_Sub,         // type
+  OP_Mul,         // type
+  OP_Div,         // type
+  OP_Rem,         // type
+  OP_Shl,         // type, type of shift amount
+  OP_Shr,         // type, type of shift amount
+  OP_And,
+  OP_Or,
+  OP_Xor,
+  OP_Neg,         // type
+  OP_BitNot,      // type
+  OP_LNot,
+  OP_Inc,         // type, whether overflow is an error
+  OP_Dec,         // type, whether overflow is an error
+  OP_EQ,
+  OP_NE,
+  OP_LT,          // type
+  OP_GT,          // type
+  OP_LE,          // type
+  OP_GE,          // type
+  OP_Jump,        // target
+  OP_JumpIfFalse, // target
+  OP_Call,        // callee index
+  OP_Return,
+  OP_Step,
+  OP_Fail
+};
+} // end anonymous namespace
+
+struct ConstexprInterpreter::Function {
+  std::vector<int64_t> Code;
+  unsigned NumParams = 0;
+  unsigned NumLocals = 0;
+  int64_t ResultType = 0;
+
+  /// \brief The functions called by this one, and their compiled forms once
+  /// they have been looked up.
+  SmallVector<const FunctionDecl *, 4> Callees;
+  mutable SmallVector<const Function *, 4> ResolvedCallees;
+};
+
+struct ConstexprInterpreter::ExecutionState {
+  unsigned MaxDepth;
+  unsigned StepsLeft;
+  unsigned DeepestCall;
+};
+
+//===----------------------------------------------------------------------===//
+// Values and types
+//===----------------------------------------------------------------------===//
+
+static int64_t makeTypeOperand(unsigned Width, bool IsSigned) {
+  return (int64_t(Width) << 1) | IsSigned;
+}
+
+static unsigned getWidth(int64_t Type) { return unsigned(Type >> 1); }
+
+static bool isSigned(int64_t Type) { return Type & 1; }
+
+static int64_t minSignedValue(unsigned Width) {
+  return Width == 64 ? INT64_MIN : -(int64_t(1) << (Width - 1));
+}
+
+static int64_t maxSignedValue(unsigned Width) {
+  return Width == 64 ? INT64_MAX : (int64_t(1) << (Width - 1)) - 1;
+}
+
+/// \brief Bring the given bits into the canonical form of a value of the
+/// given type.
+static int64_t normalize(uint64_t Bits, int64_t Type) {
+  unsigned Width = getWidth(Type);
+  if (Width == 64)
+    return Bits;
+  if (isSigned(Type))
+    return llvm::SignExtend64(Bits, Width);
+  return Bits & ((uint64_t(1) << Width) - 1);
+}
+
+static bool addOverflows(int64_t LHS, int64_t RHS, int64_t &Result) {
+  Result = int64_t(uint64_t(LHS) + uint64_t(RHS));
+  return RHS >= 0 ? Result < LHS : Result > LHS;
+}
+
+static bool subOverflows(int64_t LHS, int64_t RHS, int64_t &Result) {
+  Result = int64_t(uint64_t(LHS) - uint64_t(RHS));
+  return RHS >= 0 ? Result > LHS : Result < LHS;
+}
+
+static bool mulOverflows(int64_t LHS, int64_t RHS, int64_t &Result) {
+  Result = int64_t(uint64_t(LHS) * uint64_t(RHS));
+  if (LHS == 0 || RHS == 0)
+    return false;
+  if ((LHS == -1 && RHS == INT64_MIN) || (RHS == -1 && LHS == INT64_MIN))
+    return true;
+  return Result / RHS != LHS;
+}
+
+/// \brief Perform an arithmetic operation on two values of the given type.
+/// Returns false if the AST walker would diagnose the operation.
+static bool performArithmetic(Opcode Op, int64_t Type, int64_t LHS,
+                              int64_t RHS, int64_t &Result) {
+  if (!isSigned(Type)) {
+    uint64_t ULHS = LHS, URHS = RHS, UResult;
+    switch (Op) {
+    case OP_Add: UResult = ULHS + URHS; break;
+    case OP_Sub: UResult = ULHS - URHS; break;
+    case OP_Mul: UResult = ULHS * URHS; break;
+    case OP_Div:
+    case OP_Rem:
+      if (!URHS)
+        return false;
+      UResult = Op == OP_Div ? ULHS / URHS : ULHS % URHS;
+      break;
+    default:
+      llvm_unreachable("not an arithmetic opcode");
+    }
+    Result = normalize(UResult, Type);
+    return true;
+  }
+
+  unsigned Width = getWidth(Type);
+  bool Overflow;
+  switch (Op) {
+  case OP_Add: Overflow = addOverflows(LHS, RHS, Result); break;
+  case OP_Sub: Overflow = subOverflows(LHS, RHS, Result); break;
+  case OP_Mul: Overflow = mulOverflows(LHS, RHS, Result); break;
+  case OP_Div:
+  case OP_Rem:
+    // Division by zero, and INT_MIN / -1 and INT_MIN % -1, are diagnosed.
+    if (RHS == 0 || (RHS == -1 && LHS == minSignedValue(Width)))
+      return false;
+    Result = Op == OP_Div ? LHS / RHS : LHS % RHS;
+    return true;
+  default:
+    llvm_unreachable("not an arithmetic opcode");
+  }
+  return !Overflow && Result >= minSignedValue(Width) &&
+         Result <= maxSignedValue(Width);
+}
+
+/// \brief Perform a shift of a value of type \p Type by an amount of type
+/// \p AmountType. Returns false if the AST walker would diagnose the shift.
+static bool performShift(bool ShiftLeft, int64_t Type, int64_t AmountType,
+                         int64_t LHS, int64_t RHS, int64_t &Result) {
+  unsigned Width = getWidth(Type);
+  if ((isSigned(AmountType) && RHS < 0) || uint64_t(RHS) >= Width)
+    return false;
+  unsigned Amount = unsigned(RHS);
+
+  if (!ShiftLeft) {
+    Result = isSigned(Type) ? LHS >> Amount : int64_t(uint64_t(LHS) >> Amount);
+    return true;
+  }
+
+  // C++11 [expr.shift]p2: A signed left shift must have a non-negative
+  // operand, and must not overflow the corresponding unsigned type.
+  if (isSigned(Type) &&
+      (LHS < 0 ||
+       llvm::countLeadingZeros(uint64_t(LHS)) - (64 - Width) < Amount))
+    return false;
+  Result = normalize(uint64_t(LHS) << Amount, Type);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Compilation
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// \brief Compiles the body of one function. Every compile* function
+/// returns false if it encounters a construct that is not supported.
+class FunctionCompiler {
+  ASTContext &Ctx;
+  ConstexprInterpreter::Function &F;
+  llvm::DenseMap<const VarDecl *, unsigned> Slots;
+
+  /// \brief The jumps to patch at the end of each enclosing loop.
+  struct LoopScope {
+    SmallVector<size_t, 4> Breaks;
+    SmallVector<size_t, 4> Continues;
+  };
+  SmallVector<LoopScope, 4> Loops;
+
+public:
+  FunctionCompiler(ASTContext &Ctx, ConstexprInterpreter::Function &F)
+      : Ctx(Ctx), F(F) {}
+
+  bool compileFunction(const FunctionDecl *FD);
+
+private:
+  void emit(Opcode Op) { F.Code.push_back(Op); }
+  void emit(Opcode Op, int64_t A) {
+    F.Code.push_back(Op);
+    F.Code.push_back(A);
+  }
+  void emit(Opcode Op, int64_t A, int64_t B) {
+    F.Code.push_back(Op);
+    F.Code.push_back(A);
+    F.Code.push_back(B);
+  }
+
+  /// \brief Emit a jump whose target is not yet known, and return the
+  /// position of its target operand.
+  size_t emitJump(Opcode Op) {
+    emit(Op, 0);
+    return F.Code.size() - 1;
+  }
+  void patchJump(size_t At) { F.Code[At] = F.Code.size(); }
+
+  /// \brief Leave the innermost loop, pointing its breaks at the current
+  /// position.
+  void popLoop() {
+    for (size_t Break : Loops.back().Breaks)
+      patchJump(Break);
+    Loops.pop_back();
+  }
+
+  bool getTypeOperand(QualType T, int64_t &Type);
+  bool isSupportedObjectType(QualType T);
+  unsigned addLocal(const VarDecl *VD) {
+    unsigned Slot = F.NumLocals++;
+    Slots[VD] = Slot;
+    return Slot;
+  }
+
+  bool compileStmt(const Stmt *S);
+  bool compileLoop(const Stmt *Body, size_t ContinueTarget);
+  bool compileCondition(const Expr *Cond, size_t &FalseJump);
+  bool compileRValue(const Expr *E);
+  bool compileLValue(const Expr *E, unsigned &Slot);
+  bool compileDiscarded(const Expr *E);
+  bool compileCast(const CastExpr *E);
+  bool compileUnaryOperator(const UnaryOperator *E);
+  bool compileBinaryOperator(const BinaryOperator *E);
+  bool compileCompoundAssignment(const CompoundAssignOperator *E,
+                                 unsigned &Slot);
+  bool compileCall(const CallExpr *E);
+  bool compileGlobalVariable(const VarDecl *VD, QualType T);
+};
+} // end anonymous namespace
+
+bool FunctionCompiler::getTypeOperand(QualType T, int64_t &Type) {
+  if (T.isNull() || T->isDependentType() ||
+      !T->isIntegralOrEnumerationType() || T->isIncompleteType())
+    return false;
+  unsigned Width = Ctx.getIntWidth(T);
+  if (Width == 0 || Width > 64)
+    return false;
+  Type = makeTypeOperand(Width, !T->isUnsignedIntegerOrEnumerationType());
+  return true;
+}
+
+bool FunctionCompiler::isSupportedObjectType(QualType T) {
+  int64_t Type;
+  return !T.isVolatileQualified() && getTypeOperand(T, Type);
+}
+
+bool FunctionCompiler::compileFunction(const FunctionDecl *FD) {
+  if (FD->isVariadic() || !isa<CompoundStmt>(FD->getBody()))
+    return false;
+  if (auto *MD = dyn_cast<CXXMethodDecl>(FD))
+    if (!MD->isStatic())
+      return false;
+  if (!getTypeOperand(FD->getReturnType(), F.ResultType))
+    return false;
+
+  for (const ParmVarDecl *PVD : FD->parameters()) {
+    if (!isSupportedObjectType(PVD->getType()))
+      return false;
+    addLocal(PVD);
+  }
+  F.NumParams = FD->getNumParams();
+
+  if (!compileStmt(FD->getBody()))
+    return false;
+
+  // Flowing off the end of the function is diagnosed.
+  emit(OP_Fail);
+  F.ResolvedCallees.resize(F.Callees.size());
+  return true;
+}
+
+bool FunctionCompiler::compileStmt(const Stmt *S) {
+  // The AST walker takes one step for every statement it evaluates.
+  emit(OP_Step);
+
+  switch (S->getStmtClass()) {
+  case Stmt::NullStmtClass:
+    return true;
+
+  case Stmt::CompoundStmtClass:
+    for (const Stmt *Child : cast<CompoundStmt>(S)->body())
+      if (!compileStmt(Child))
+        return false;
+    return true;
+
+  case Stmt::DeclStmtClass:
+    for (const Decl *D : cast<DeclStmt>(S)->decls()) {
+      if (isa<TypeDecl>(D) || isa<StaticAssertDecl>(D) ||
+          isa<UsingDecl>(D) || isa<UsingDirectiveDecl>(D) ||
+          isa<UsingShadowDecl>(D))
+        continue;
+      auto *VD = dyn_cast<VarDecl>(D);
+      if (!VD || !VD->hasLocalStorage() || !VD->getInit() ||
+          !isSupportedObjectType(VD->getType()))
+        return false;
+      // The variable is not in scope in its own initializer, so that the
+      // AST walker diagnoses any use of its uninitialized value.
+      if (!compileRValue(VD->getInit()))
+        return false;
+      emit(OP_SetLocal, addLocal(VD));
+    }
+    return true;
+
+  case Stmt::ReturnStmtClass: {
+    const Expr *RetValue = cast<ReturnStmt>(S)->getRetValue();
+    if (!RetValue || !compileRValue(RetValue))
+      return false;
+    emit(OP_Return);
+    return true;
+  }
+
+  case Stmt::IfStmtClass: {
+    auto *IS = cast<IfStmt>(S);
+    if (IS->getConditionVariable())
+      return false;
+    if (IS->getInit() && !compileStmt(IS->getInit()))
+      return false;
+    size_t ElseJump;
+    if (!compileCondition(IS->getCond(), ElseJump) ||
+        !compileStmt(IS->getThen()))
+      return false;
+    if (!IS->getElse()) {
+      patchJump(ElseJump);
+      return true;
+    }
+    size_t EndJump = emitJump(OP_Jump);
+    patchJump(ElseJump);
+    if (!compileStmt(IS->getElse()))
+      return false;
+    patchJump(EndJump);
+    return true;
+  }
+
+  case Stmt::WhileStmtClass: {
+    auto *WS = cast<WhileStmt>(S);
+    if (WS->getConditionVariable())
+      return false;
+    size_t Top = F.Code.size();
+    size_t ExitJump;
+    if (!compileCondition(WS->getCond(), ExitJump) ||
+        !compileLoop(WS->getBody(), Top))
+      return false;
+    patchJump(ExitJump);
+    popLoop();
+    return true;
+  }
+
+  case Stmt::DoStmtClass: {
+    auto *DS = cast<DoStmt>(S);
+    size_t Top = F.Code.size();
+    Loops.emplace_back();
+    if (!compileStmt(DS->getBody()))
+      return false;
+    for (size_t Continue : Loops.back().Continues)
+      patchJump(Continue);
+    size_t ExitJump;
+    if (!compileCondition(DS->getCond(), ExitJump))
+      return false;
+    emit(OP_Jump, Top);
+    patchJump(ExitJump);
+    popLoop();
+    return true;
+  }
+
+  case Stmt::ForStmtClass: {
+    auto *FS = cast<ForStmt>(S);
+    if (FS->getConditionVariable())
+      return false;
+    if (FS->getInit() && !compileStmt(FS->getInit()))
+      return false;
+
+    // The increment is compiled before the condition and the body, and
+    // jumped over on entry, so that 'continue' has a known target.
+    size_t EntryJump = emitJump(OP_Jump);
+    size_t IncTarget = F.Code.size();
+    if (FS->getInc() && !compileDiscarded(FS->getInc()))
+      return false;
+    patchJump(EntryJump);
+
+    size_t ExitJump = 0;
+    if (FS->getCond() && !compileCondition(FS->getCond(), ExitJump))
+      return false;
+    if (!compileLoop(FS->getBody(), IncTarget))
+      return false;
+    if (FS->getCond())
+      patchJump(ExitJump);
+    popLoop();
+    return true;
+  }
+
+  case Stmt::BreakStmtClass:
+    if (Loops.empty())
+      return false;
+    Loops.back().Breaks.push_back(emitJump(OP_Jump));
+    return true;
+
+  case Stmt::ContinueStmtClass:
+    if (Loops.empty())
+      return false;
+    Loops.back().Continues.push_back(emitJump(OP_Jump));
+    return true;
+
+  case Stmt::AttributedStmtClass:
+    return compileStmt(cast<AttributedStmt>(S)->getSubStmt());
+
+  default:
+    if (auto *E = dyn_cast<Expr>(S))
+      return compileDiscarded(E);
+    return false;
+  }
+}
+
+/// \brief Compile the body of a while or for loop, followed by a jump back
+/// to \p ContinueTarget. The loop's scope is left on the stack so that the
+/// caller can patch its breaks.
+bool FunctionCompiler::compileLoop(const Stmt *Body, size_t ContinueTarget) {
+  Loops.emplace_back();
+  if (!compileStmt(Body))
+    return false;
+  for (size_t Continue : Loops.back().Continues)
+    F.Code[Continue] = ContinueTarget;
+  emit(OP_Jump, ContinueTarget);
+  return true;
+}
+
+bool FunctionCompiler::compileCondition(const Expr *Cond, size_t &FalseJump) {
+  if (!compileRValue(Cond))
+    return false;
+  FalseJump = emitJump(OP_JumpIfFalse);
+  return true;
+}
+
+bool FunctionCompiler::compileDiscarded(const Expr *E) {
+  E = E->IgnoreParens();
+
+  if (auto *CE = dyn_cast<CastExpr>(E))
+    if (CE->getCastKind() == CK_ToVoid)
+      return compileDiscarded(CE->getSubExpr());
+
+  if (auto *BO = dyn_cast<BinaryOperator>(E))
+    if (BO->getOpcode() == BO_Comma)
+      return compileDiscarded(BO->getLHS()) && compileDiscarded(BO->getRHS());
+
+  if (E->isGLValue()) {
+    unsigned Slot;
+    return compileLValue(E, Slot);
+  }
+
+  if (!compileRValue(E))
+    return false;
+  emit(OP_Pop);
+  return true;
+}
+
+bool FunctionCompiler::compileLValue(const Expr *E, unsigned &Slot) {
+  E = E->IgnoreParens();
+  if (!isSupportedObjectType(E->getType()))
+    return false;
+
+  if (auto *DRE = dyn_cast<DeclRefExpr>(E)) {
+    auto *VD = dyn_cast<VarDecl>(DRE->getDecl());
+    auto Known = VD ? Slots.find(VD) : Slots.end();
+    if (Known == Slots.end())
+      return false;
+    Slot = Known->second;
+    return true;
+  }
+
+  if (auto *CAO = dyn_cast<CompoundAssignOperator>(E))
+    return compileCompoundAssignment(CAO, Slot);
+
+  if (auto *BO = dyn_cast<BinaryOperator>(E)) {
+    if (BO->getOpcode() == BO_Comma)
+      return compileDiscarded(BO->getLHS()) &&
+             compileLValue(BO->getRHS(), Slot);
+    if (BO->getOpcode() != BO_Assign)
+      return false;
+    if (!compileLValue(BO->getLHS(), Slot) || !compileRValue(BO->getRHS()))
+      return false;
+    emit(OP_SetLocal, Slot);
+    return true;
+  }
+
+  if (auto *UO = dyn_cast<UnaryOperator>(E)) {
+    if (UO->getOpcode() != UO_PreInc && UO->getOpcode() != UO_PreDec)
+      return false;
+    int64_t Type;
+    if (UO->getType()->isBooleanType() ||
+        !getTypeOperand(UO->getType(), Type) ||
+        !compileLValue(UO->getSubExpr(), Slot))
+      return false;
+    // Only types that are not promoted by the increment can overflow.
+    bool Checked = isSigned(Type) &&
+                   getWidth(Type) >= Ctx.getIntWidth(Ctx.IntTy);
+    emit(OP_GetLocal, Slot);
+    emit(UO->getOpcode() == UO_PreInc ? OP_Inc : OP_Dec, Type, Checked);
+    emit(OP_SetLocal, Slot);
+    return true;
+  }
+
+  return false;
+}
+
+bool FunctionCompiler::compileRValue(const Expr *E) {
+  E = E->IgnoreParens();
+  if (!E->isRValue())
+    return false;
+  int64_t Type;
+  if (!getTypeOperand(E->getType(), Type))
+    return false;
+
+  switch (E->getStmtClass()) {
+  case Stmt::IntegerLiteralClass:
+    emit(OP_Const,
+         normalize(cast<IntegerLiteral>(E)->getValue().getZExtValue(), Type));
+    return true;
+
+  case Stmt::CharacterLiteralClass:
+    emit(OP_Const, normalize(cast<CharacterLiteral>(E)->getValue(), Type));
+    return true;
+
+  case Stmt::CXXBoolLiteralExprClass:
+    emit(OP_Const, cast<CXXBoolLiteralExpr>(E)->getValue());
+    return true;
+
+  case Stmt::SubstNonTypeTemplateParmExprClass:
+    return compileRValue(
+        cast<SubstNonTypeTemplateParmExpr>(E)->getReplacement());
+
+  case Stmt::UnaryExprOrTypeTraitExprClass: {
+    llvm::APSInt Value;
+    if (!E->EvaluateAsInt(Value, Ctx))
+      return false;
+    emit(OP_Const, normalize(Value.getZExtValue(), Type));
+    return true;
+  }
+
+  case Stmt::DeclRefExprClass: {
+    auto *ECD = dyn_cast<EnumConstantDecl>(cast<DeclRefExpr>(E)->getDecl());
+    if (!ECD || ECD->getInitVal().getMinSignedBits() > 64)
+      return false;
+    emit(OP_Const, normalize(ECD->getInitVal().getSExtValue(), Type));
+    return true;
+  }
+
+  case Stmt::ConditionalOperatorClass: {
+    auto *CO = cast<ConditionalOperator>(E);
+    size_t FalseJump;
+    if (!compileCondition(CO->getCond(), FalseJump) ||
+        !compileRValue(CO->getTrueExpr()))
+      return false;
+    size_t EndJump = emitJump(OP_Jump);
+    patchJump(FalseJump);
+    if (!compileRValue(CO->getFalseExpr()))
+      return false;
+    patchJump(EndJump);
+    return true;
+  }
+
+  case Stmt::ImplicitCastExprClass:
+  case Stmt::CStyleCastExprClass:
+  case Stmt::CXXFunctionalCastExprClass:
+  case Stmt::CXXStaticCastExprClass:
+    return compileCast(cast<CastExpr>(E));
+
+  case Stmt::UnaryOperatorClass:
+    return compileUnaryOperator(cast<UnaryOperator>(E));
+
+  case Stmt::BinaryOperatorClass:
+    return compileBinaryOperator(cast<BinaryOperator>(E));
+
+  case Stmt::CallExprClass:
+    return compileCall(cast<CallExpr>(E));
+
+  default:
+    return false;
+  }
+}
+
+/// \brief Compile a read of a global variable whose value the AST walker
+/// would read without any diagnostic: a constexpr variable, or a const
+/// integral one, with a constant initializer.
+bool FunctionCompiler::compileGlobalVariable(const VarDecl *VD, QualType T) {
+  QualType VarType = VD->getType();
+  if (VD->hasLocalStorage() || VD->isWeak() || VarType->isReferenceType() ||
+      VarType.isVolatileQualified() ||
+      !(VD->isConstexpr() || VarType.isConstQualified()))
+    return false;
+  const Expr *Init = VD->getAnyInitializer();
+  if (!Init || Init->isValueDependent())
+    return false;
+  const APValue *Value = VD->evaluateValue();
+  if (!Value || !Value->isInt() || Value->getInt().getMinSignedBits() > 64 ||
+      !VD->checkInitIsICE())
+    return false;
+  int64_t Type;
+  if (!getTypeOperand(T, Type))
+    return false;
+  emit(OP_Const, normalize(Value->getInt().getExtValue(), Type));
+  return true;
+}
+
+bool FunctionCompiler::compileCast(const CastExpr *E) {
+  const Expr *SubExpr = E->getSubExpr();
+  int64_t Type;
+  if (!getTypeOperand(E->getType(), Type))
+    return false;
+
+  switch (E->getCastKind()) {
+  case CK_LValueToRValue: {
+    unsigned Slot;
+    auto *DRE = dyn_cast<DeclRefExpr>(SubExpr->IgnoreParens());
+    if (DRE && isa<VarDecl>(DRE->getDecl()) &&
+        !Slots.count(cast<VarDecl>(DRE->getDecl())))
+      return compileGlobalVariable(cast<VarDecl>(DRE->getDecl()),
+                                   SubExpr->getType());
+    if (!compileLValue(SubExpr, Slot))
+      return false;
+    emit(OP_GetLocal, Slot);
+    return true;
+  }
+
+  case CK_NoOp:
+    return compileRValue(SubExpr);
+
+  case CK_IntegralCast:
+    if (!compileRValue(SubExpr))
+      return false;
+    emit(OP_Convert, Type);
+    return true;
+
+  case CK_IntegralToBoolean:
+    if (!compileRValue(SubExpr))
+      return false;
+    emit(OP_ToBool);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+bool FunctionCompiler::compileUnaryOperator(const UnaryOperator *E) {
+  int64_t Type;
+  if (!getTypeOperand(E->getType(), Type))
+    return false;
+
+  switch (E->getOpcode()) {
+  case UO_Plus:
+    return compileRValue(E->getSubExpr());
+
+  case UO_Minus:
+  case UO_Not:
+    if (!compileRValue(E->getSubExpr()))
+      return false;
+    emit(E->getOpcode() == UO_Minus ? OP_Neg : OP_BitNot, Type);
+    return true;
+
+  case UO_LNot:
+    if (!compileRValue(E->getSubExpr()))
+      return false;
+    emit(OP_LNot);
+    return true;
+
+  case UO_PostInc:
+  case UO_PostDec: {
+    unsigned Slot;
+    if (E->getType()->isBooleanType() || !compileLValue(E->getSubExpr(), Slot))
+      return false;
+    bool Checked = isSigned(Type) &&
+                   getWidth(Type) >= Ctx.getIntWidth(Ctx.IntTy);
+    emit(OP_GetLocal, Slot);
+    emit(OP_Dup);
+    emit(E->getOpcode() == UO_PostInc ? OP_Inc : OP_Dec, Type, Checked);
+    emit(OP_SetLocal, Slot);
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+static Opcode getArithmeticOpcode(BinaryOperatorKind Opc) {
+  switch (Opc) {
+  case BO_Mul: return OP_Mul;
+  case BO_Div: return OP_Div;
+  case BO_Rem: return OP_Rem;
+  case BO_Add: return OP_Add;
+  case BO_Sub: return OP_Sub;
+  case BO_Shl: return OP_Shl;
+  case BO_Shr: return OP_Shr;
+  case BO_And: return OP_And;
+  case BO_Xor: return OP_Xor;
+  case BO_Or:  return OP_Or;
+  case BO_LT:  return OP_LT;
+  case BO_GT:  return OP_GT;
+  case BO_LE:  return OP_LE;
+  case BO_GE:  return OP_GE;
+  case BO_EQ:  return OP_EQ;
+  case BO_NE:  return OP_NE;
+  default:     return OP_Fail;
+  }
+}
+
+bool FunctionCompiler::compileBinaryOperator(const BinaryOperator *E) {
+  BinaryOperatorKind Opc = E->getOpcode();
+
+  if (Opc == BO_Comma)
+    return compileDiscarded(E->getLHS()) && compileRValue(E->getRHS());
+
+  if (Opc == BO_LAnd || Opc == BO_LOr) {
+    // a && b  =>  a; jf L; b; tobool; jmp End; L: const 0; End:
+    // a || b  =>  a; lnot; jf L; b; tobool; jmp End; L: const 1; End:
+    if (!compileRValue(E->getLHS()))
+      return false;
+    if (Opc == BO_LOr)
+      emit(OP_LNot);
+    size_t ShortCircuit = emitJump(OP_JumpIfFalse);
+    if (!compileRValue(E->getRHS()))
+      return false;
+    emit(OP_ToBool);
+    size_t EndJump = emitJump(OP_Jump);
+    patchJump(ShortCircuit);
+    emit(OP_Const, Opc == BO_LOr);
+    patchJump(EndJump);
+    return true;
+  }
+
+  Opcode Op = getArithmeticOpcode(Opc);
+  int64_t OperandType, RHSType;
+  if (Op == OP_Fail ||
+      !getTypeOperand(E->getLHS()->getType(), OperandType) ||
+      !getTypeOperand(E->getRHS()->getType(), RHSType) ||
+      !compileRValue(E->getLHS()) || !compileRValue(E->getRHS()))
+    return false;
+
+  switch (Op) {
+  case OP_Shl:
+  case OP_Shr:
+    emit(Op, OperandType, RHSType);
+    break;
+  case OP_And:
+  case OP_Or:
+  case OP_Xor:
+  case OP_EQ:
+  case OP_NE:
+    emit(Op);
+    break;
+  default:
+    emit(Op, OperandType);
+    break;
+  }
+  return true;
+}
+
+bool FunctionCompiler::compileCompoundAssignment(
+    const CompoundAssignOperator *E, unsigned &Slot) {
+  Opcode Op = getArithmeticOpcode(E->getOpcode());
+  int64_t LHSType, ComputationType, RHSType;
+  if (Op == OP_Fail ||
+      !getTypeOperand(E->getLHS()->getType(), LHSType) ||
+      !getTypeOperand(E->getComputationLHSType(), ComputationType) ||
+      !getTypeOperand(E->getRHS()->getType(), RHSType) ||
+      !E->getComputationResultType()->isIntegralOrEnumerationType())
+    return false;
+
+  if (!compileLValue(E->getLHS(), Slot))
+    return false;
+  emit(OP_GetLocal, Slot);
+  emit(OP_Convert, ComputationType);
+  if (!compileRValue(E->getRHS()))
+    return false;
+  if (Op == OP_Shl || Op == OP_Shr)
+    emit(Op, ComputationType, RHSType);
+  else if (Op == OP_And || Op == OP_Or || Op == OP_Xor)
+    emit(Op);
+  else
+    emit(Op, ComputationType);
+  emit(OP_Convert, LHSType);
+  emit(OP_SetLocal, Slot);
+  return true;
+}
+
+bool FunctionCompiler::compileCall(const CallExpr *E) {
+  auto *DRE = dyn_cast<DeclRefExpr>(E->getCallee()->IgnoreParenImpCasts());
+  const FunctionDecl *FD = E->getDirectCallee();
+  if (!DRE || !FD || DRE->getDecl() != FD || FD->getBuiltinID() ||
+      FD->isVariadic() || E->getNumArgs() != FD->getNumParams())
+    return false;
+  if (auto *MD = dyn_cast<CXXMethodDecl>(FD))
+    if (!MD->isStatic())
+      return false;
+
+  for (unsigned I = 0, N = E->getNumArgs(); I != N; ++I)
+    if (!isSupportedObjectType(FD->getParamDecl(I)->getType()) ||
+        !compileRValue(E->getArg(I)))
+      return false;
+
+  emit(OP_Call, F.Callees.size());
+  F.Callees.push_back(FD);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Execution
+//===----------------------------------------------------------------------===//
+
+ConstexprInterpreter::ConstexprInterpreter(ASTContext &Ctx) : Ctx(Ctx) {}
+
+ConstexprInterpreter::~ConstexprInterpreter() {}
+
+const ConstexprInterpreter::Function *
+ConstexprInterpreter::getFunction(const FunctionDecl *FD) {
+  const FunctionDecl *Definition = nullptr;
+  if (FD->isInvalidDecl() || !FD->getBody(Definition) ||
+      !Definition->isConstexpr() || Definition->isInvalidDecl())
+    return nullptr;
+
+  auto Known = Functions.find(Definition);
+  if (Known != Functions.end())
+    return Known->second.get();
+
+  // Compiling may evaluate the initializers of global variables, and so
+  // come back here; treat the function as uncompilable until it is done.
+  Functions[Definition] = nullptr;
+  std::unique_ptr<Function> F(new Function);
+  if (!FunctionCompiler(Ctx, *F).compileFunction(Definition)) {
+    ++NumFunctionsRejected;
+    return nullptr;
+  }
+  ++NumFunctionsCompiled;
+  return (Functions[Definition] = std::move(F)).get();
+}
+
+bool ConstexprInterpreter::execute(const Function &F, const int64_t *Args,
+                                   unsigned Depth, ExecutionState &State,
+                                   int64_t &Result) {
+  SmallVector<int64_t, 16> Locals(F.NumLocals);
+  std::copy(Args, Args + F.NumParams, Locals.begin());
+  SmallVector<int64_t, 16> Stack;
+
+  const int64_t *Code = F.Code.data();
+  size_t PC = 0;
+  while (true) {
+    Opcode Op = Opcode(Code[PC++]);
+    switch (Op) {
+    case OP_Const:
+      Stack.push_back(Code[PC++]);
+      break;
+    case OP_GetLocal:
+      Stack.push_back(Locals[Code[PC++]]);
+      break;
+    case OP_SetLocal:
+      Locals[Code[PC++]] = Stack.pop_back_val();
+      break;
+    case OP_Pop:
+      Stack.pop_back();
+      break;
+    case OP_Dup:
+      Stack.push_back(Stack.back());
+      break;
+    case OP_Convert:
+      Stack.back() = normalize(Stack.back(), Code[PC++]);
+      break;
+    case OP_ToBool:
+      Stack.back() = Stack.back() != 0;
+      break;
+
+    case OP_Add:
+    case OP_Sub:
+    case OP_Mul:
+    case OP_Div:
+    case OP_Rem: {
+      int64_t RHS = Stack.pop_back_val();
+      if (!performArithmetic(Op, Code[PC++], Stack.back(), RHS, Stack.back()))
+        return false;
+      break;
+    }
+    case OP_Shl:
+    case OP_Shr: {
+      int64_t RHS = Stack.pop_back_val();
+      if (!performShift(Op == OP_Shl, Code[PC], Code[PC + 1], Stack.back(),
+                        RHS, Stack.back()))
+        return false;
+      PC += 2;
+      break;
+    }
+    case OP_And: {
+      int64_t RHS = Stack.pop_back_val();
+      Stack.back() &= RHS;
+      break;
+    }
+    case OP_Or: {
+      int64_t RHS = Stack.pop_back_val();
+      Stack.back() |= RHS;
+      break;
+    }
+    case OP_Xor: {
+      int64_t RHS = Stack.pop_back_val();
+      Stack.back() ^= RHS;
+      break;
+    }
+
+    case OP_Neg: {
+      int64_t Type = Code[PC++];
+      int64_t &Value = Stack.back();
+      if (isSigned(Type) && Value == minSignedValue(getWidth(Type)))
+        return false;
+      Value = normalize(0 - uint64_t(Value), Type);
+      break;
+    }
+    case OP_BitNot:
+      Stack.back() = normalize(~uint64_t(Stack.back()), Code[PC++]);
+      break;
+    case OP_LNot:
+      Stack.back() = Stack.back() == 0;
+      break;
+    case OP_Inc:
+    case OP_Dec: {
+      int64_t Type = Code[PC], Checked = Code[PC + 1];
+      PC += 2;
+      int64_t &Value = Stack.back();
+      if (Checked &&
+          Value == (Op == OP_Inc ? maxSignedValue(getWidth(Type))
+                                 : minSignedValue(getWidth(Type))))
+        return false;
+      Value = normalize(uint64_t(Value) + (Op == OP_Inc ? 1 : -1), Type);
+      break;
+    }
+
+    case OP_EQ:
+    case OP_NE: {
+      int64_t RHS = Stack.pop_back_val();
+      Stack.back() = (Stack.back() == RHS) == (Op == OP_EQ);
+      break;
+    }
+    case OP_LT:
+    case OP_GT:
+    case OP_LE:
+    case OP_GE: {
+      int64_t RHS = Stack.pop_back_val();
+      int64_t &LHS = Stack.back();
+      int Order;
+      if (isSigned(Code[PC++]))
+        Order = LHS < RHS ? -1 : LHS > RHS;
+      else
+        Order = uint64_t(LHS) < uint64_t(RHS) ? -1
+                                              : uint64_t(LHS) > uint64_t(RHS);
+      switch (Op) {
+      case OP_LT: LHS = Order < 0; break;
+      case OP_GT: LHS = Order > 0; break;
+      case OP_LE: LHS = Order <= 0; break;
+      default:    LHS = Order >= 0; break;
+      }
+      break;
+    }
+
+    case OP_Jump:
+      PC = Code[PC];
+      break;
+    case OP_JumpIfFalse:
+      if (Stack.pop_back_val())
+        ++PC;
+      else
+        PC = Code[PC];
+      break;
+
+    case OP_Call: {
+      unsigned Index = Code[PC++];
+      const Function *Callee = F.ResolvedCallees[Index];
+      if (!Callee) {
+        Callee = getFunction(F.Callees[Index]);
+        if (!Callee)
+          return false;
+        F.ResolvedCallees[Index] = Callee;
+      }
+      if (Depth + 1 > State.MaxDepth)
+        return false;
+      State.DeepestCall = std::max(State.DeepestCall, Depth + 1);
+      int64_t CallResult;
+      const int64_t *CallArgs = Stack.end() - Callee->NumParams;
+      if (!execute(*Callee, CallArgs, Depth + 1, State, CallResult))
+        return false;
+      Stack.resize(Stack.size() - Callee->NumParams);
+      Stack.push_back(CallResult);
+      break;
+    }
+    case OP_Return:
+      Result = Stack.pop_back_val();
+      return true;
+
+    case OP_Step:
+      if (!State.StepsLeft)
+        return false;
+      --State.StepsLeft;
+      break;
+    case OP_Fail:
+      return false;
+    }
+  }
+}
+
+ConstexprInterpreter::CallResult
+ConstexprInterpreter::evaluateCall(const FunctionDecl *Definition,
+                                   ArrayRef<APValue> Args, unsigned MaxDepth,
+                                   unsigned &StepsLeft, unsigned &NestedDepth,
+                                   APValue &Result) {
+  ++NumCallsAttempted;
+  const Function *F = getFunction(Definition);
+  if (!F || Args.size() != F->NumParams)
+    return CR_Unsupported;
+
+  SmallVector<int64_t, 8> ArgWords;
+  for (const APValue &Arg : Args) {
+    if (!Arg.isInt() || Arg.getInt().getBitWidth() > 64)
+      return CR_Unsupported;
+    const llvm::APSInt &Value = Arg.getInt();
+    ArgWords.push_back(Value.isSigned() ? Value.getSExtValue()
+                                        : int64_t(Value.getZExtValue()));
+  }
+
+  ExecutionState State = {MaxDepth, StepsLeft, 0};
+  int64_t ResultWord;
+  if (!execute(*F, ArgWords.data(), 0, State, ResultWord)) {
+    ++NumCallsGivenUp;
+    return CR_GaveUp;
+  }
+
+  ++NumCallsEvaluated;
+  StepsLeft = State.StepsLeft;
+  NestedDepth = State.DeepestCall;
+  unsigned Width = getWidth(F->ResultType);
+  bool IsSigned = isSigned(F->ResultType);
+  Result = APValue(llvm::APSInt(llvm::APInt(Width, uint64_t(ResultWord),
+                                            IsSigned),
+                                !IsSigned));
+  return CR_Evaluated;
+}
+
+void ConstexprInterpreter::PrintStats() const {
+  llvm::errs() << NumFunctionsCompiled << "/"
+               << (NumFunctionsCompiled + NumFunctionsRejected)
+               << " constexpr functions compiled to bytecode\n";
+  llvm::errs() << NumCallsEvaluated << "/" << NumCallsAttempted
+               << " constexpr calls evaluated by the bytecode interpreter\n";
+  llvm::errs() << NumCallsGivenUp
+               << " constexpr calls given up by the bytecode interpreter\n";
+}
@@ -13,6 +13,7 @@
 
 #include "clang/AST/DeclBase.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/ASTMemoryAccounting.h"
 #include "clang/AST/ASTMutationListener.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/Decl.h"
@@ -68,6 +69,9 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
   // Store the global declaration ID in the second 4 bytes.
   PrefixPtr[1] = ID;
 
+  if (ASTMemoryAccounting *Accounting = Context.getMemoryAccounting())
+    Accounting->noteDecl(static_cast<Decl *>(Result), Size + Extra + 8);
+
   return Result;
 }
 
@@ -82,12 +86,18 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Ctx,
     size_t ExtraAlign =
         llvm::OffsetToAlignment(sizeof(Module *),
                                 llvm::AlignOf<Decl>::Alignment);
-    char *Buffer = reinterpret_cast<char *>(
-        ::operator new(ExtraAlign + sizeof(Module *) + Size + Extra, Ctx));
+    size_t TotalSize = ExtraAlign + sizeof(Module *) + Size + Extra;
+    char *Buffer = reinterpret_cast<char *>(::operator new(TotalSize, Ctx));
     Buffer += ExtraAlign;
-    return new (Buffer) Module*(nullptr) + 1;
+    void *Result = new (Buffer) Module*(nullptr) + 1;
+    if (ASTMemoryAccounting *Accounting = Ctx.getMemoryAccounting())
+      Accounting->noteDecl(static_cast<Decl *>(Result), TotalSize);
+    return Result;
   }
-  return ::operator new(Size + Extra, Ctx);
+  void *Result = ::operator new(Size + Extra, Ctx);
+  if (ASTMemoryAccounting *Accounting = Ctx.getMemoryAccounting())
+    Accounting->noteDecl(static_cast<Decl *>(Result), Size + Extra);
+  return Result;
 }
 
 Module *Decl::getOwningModuleSlow() const {
@@ -1125,16 +1125,43 @@ OverloadedOperatorKind UnaryOperator::getOverloadedOperator(Opcode Opc) {
 // Postfix Operators.
 //===----------------------------------------------------------------------===//
 
-CallExpr::CallExpr(const ASTContext &C, StmtClass SC, Expr *fn,
-                   ArrayRef<Expr *> preargs, ArrayRef<Expr *> args, QualType t,
-                   ExprValueKind VK, SourceLocation rparenloc)
+unsigned CallExpr::offsetToTrailingStmts(StmtClass SC) {
+  switch (SC) {
+  case CallExprClass:
+    return sizeof(CallExpr);
+  case CXXOperatorCallExprClass:
+    return sizeof(CXXOperatorCallExpr);
+  case CXXMemberCallExprClass:
+    return sizeof(CXXMemberCallExpr);
+  case CUDAKernelCallExprClass:
+    return sizeof(CUDAKernelCallExpr);
+  case UserDefinedLiteralClass:
+    return sizeof(UserDefinedLiteral);
+  default:
+    llvm_unreachable("unexpected class deriving from CallExpr!");
+  }
+}
+
+CallExpr::CallExpr(StmtClass SC, Expr *fn, ArrayRef<Expr *> preargs,
+                   ArrayRef<Expr *> args, QualType t, ExprValueKind VK,
+                   SourceLocation rparenloc, unsigned MinNumArgs)
     : Expr(SC, t, VK, OK_Ordinary, fn->isTypeDependent(),
            fn->isValueDependent(), fn->isInstantiationDependent(),
            fn->containsUnexpandedParameterPack()),
-      NumArgs(args.size()) {
-
+      NumArgs(args.size()), RParenLoc(rparenloc) {
+#ifndef NDEBUG
+  NumArgsCapacity = std::max<unsigned>(args.size(), MinNumArgs);
+#endif
   unsigned NumPreArgs = preargs.size();
-  SubExprs = new (C) Stmt *[args.size()+PREARGS_START+NumPreArgs];
+  CallExprBits.NumPreArgs = NumPreArgs;
+  assert(NumPreArgs == getNumPreArgs() && "NumPreArgs overflow!");
+  unsigned OffsetToTrailingStmts = offsetToTrailingStmts(SC);
+  CallExprBits.OffsetToTrailingStmts = OffsetToTrailingStmts;
+  assert(OffsetToTrailingStmts == CallExprBits.OffsetToTrailingStmts &&
+         "OffsetToTrailingStmts overflow!");
+  (void)OffsetToTrailingStmts;
+
+  Stmt **SubExprs = getTrailingStmts();
   SubExprs[FN] = fn;
   for (unsigned i = 0; i != NumPreArgs; ++i) {
     updateDependenciesFromArg(preargs[i]);
@@ -1144,30 +1171,56 @@ CallExpr::CallExpr(const ASTContext &C, StmtClass SC, Expr *fn,
     updateDependenciesFromArg(args[i]);
     SubExprs[i+PREARGS_START+NumPreArgs] = args[i];
   }
+  // Null out the arguments reserved for later.
+  for (unsigned i = args.size(); i < MinNumArgs; ++i)
+    SubExprs[i+PREARGS_START+NumPreArgs] = nullptr;
+}
+
+CallExpr::CallExpr(StmtClass SC, Expr *fn, ArrayRef<Expr *> args, QualType t,
+                   ExprValueKind VK, SourceLocation rparenloc,
+                   unsigned MinNumArgs)
+    : CallExpr(SC, fn, ArrayRef<Expr *>(), args, t, VK, rparenloc,
+               MinNumArgs) {}
 
+CallExpr::CallExpr(StmtClass SC, unsigned NumPreArgs, unsigned NumArgs,
+                   EmptyShell Empty)
+    : Expr(SC, Empty), NumArgs(NumArgs) {
+#ifndef NDEBUG
+  NumArgsCapacity = NumArgs;
+#endif
   CallExprBits.NumPreArgs = NumPreArgs;
-  RParenLoc = rparenloc;
+  assert(NumPreArgs == getNumPreArgs() && "NumPreArgs overflow!");
+  unsigned OffsetToTrailingStmts = offsetToTrailingStmts(SC);
+  CallExprBits.OffsetToTrailingStmts = OffsetToTrailingStmts;
+  assert(OffsetToTrailingStmts == CallExprBits.OffsetToTrailingStmts &&
+         "OffsetToTrailingStmts overflow!");
+  (void)OffsetToTrailingStmts;
+  std::fill_n(getTrailingStmts(), PREARGS_START + NumPreArgs + NumArgs,
+              nullptr);
 }
 
-CallExpr::CallExpr(const ASTContext &C, StmtClass SC, Expr *fn,
-                   ArrayRef<Expr *> args, QualType t, ExprValueKind VK,
-                   SourceLocation rparenloc)
-    : CallExpr(C, SC, fn, ArrayRef<Expr *>(), args, t, VK, rparenloc) {}
-
-CallExpr::CallExpr(const ASTContext &C, Expr *fn, ArrayRef<Expr *> args,
-                   QualType t, ExprValueKind VK, SourceLocation rparenloc)
-    : CallExpr(C, CallExprClass, fn, ArrayRef<Expr *>(), args, t, VK, rparenloc) {
+CallExpr *CallExpr::Create(const ASTContext &C, Expr *Fn,
+                           ArrayRef<Expr *> Args, QualType Ty,
+                           ExprValueKind VK, SourceLocation RParenLoc,
+                           unsigned MinNumArgs) {
+  unsigned NumArgs = std::max<unsigned>(Args.size(), MinNumArgs);
+  void *Mem = C.Allocate(sizeToAllocate(CallExprClass, 0, NumArgs),
+                         llvm::alignOf<CallExpr>());
+  return new (Mem)
+      CallExpr(CallExprClass, Fn, Args, Ty, VK, RParenLoc, MinNumArgs);
 }
 
-CallExpr::CallExpr(const ASTContext &C, StmtClass SC, EmptyShell Empty)
-    : CallExpr(C, SC, /*NumPreArgs=*/0, Empty) {}
+CallExpr *CallExpr::CreateTemporary(void *Mem, Expr *Fn, QualType Ty,
+                                    ExprValueKind VK,
+                                    SourceLocation RParenLoc) {
+  return new (Mem) CallExpr(CallExprClass, Fn, None, Ty, VK, RParenLoc);
+}
 
-CallExpr::CallExpr(const ASTContext &C, StmtClass SC, unsigned NumPreArgs,
-                   EmptyShell Empty)
-  : Expr(SC, Empty), SubExprs(nullptr), NumArgs(0) {
-  // FIXME: Why do we allocate this?
-  SubExprs = new (C) Stmt*[PREARGS_START+NumPreArgs]();
-  CallExprBits.NumPreArgs = NumPreArgs;
+CallExpr *CallExpr::CreateEmpty(const ASTContext &C, unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CallExprClass, 0, NumArgs),
+                         llvm::alignOf<CallExpr>());
+  return new (Mem)
+      CallExpr(CallExprClass, /*NumPreArgs=*/0, NumArgs, EmptyShell());
 }
 
 void CallExpr::updateDependenciesFromArg(Expr *Arg) {
@@ -1209,35 +1262,6 @@ FunctionDecl *CallExpr::getDirectCallee() {
   return dyn_cast_or_null<FunctionDecl>(getCalleeDecl());
 }
 
-/// setNumArgs - This changes the number of arguments present in this call.
-/// Any orphaned expressions are deleted by this, and any new operands are set
-/// to null.
-void CallExpr::setNumArgs(const ASTContext& C, unsigned NumArgs) {
-  // No change, just return.
-  if (NumArgs == getNumArgs()) return;
-
-  // If shrinking # arguments, just delete the extras and forgot them.
-  if (NumArgs < getNumArgs()) {
-    this->NumArgs = NumArgs;
-    return;
-  }
-
-  // Otherwise, we are growing the # arguments.  New an bigger argument array.
-  unsigned NumPreArgs = getNumPreArgs();
-  Stmt **NewSubExprs = new (C) Stmt*[NumArgs+PREARGS_START+NumPreArgs];
-  // Copy over args.
-  for (unsigned i = 0; i != getNumArgs()+PREARGS_START+NumPreArgs; ++i)
-    NewSubExprs[i] = SubExprs[i];
-  // Null out new args.
-  for (unsigned i = getNumArgs()+PREARGS_START+NumPreArgs;
-       i != NumArgs+PREARGS_START+NumPreArgs; ++i)
-    NewSubExprs[i] = nullptr;
-
-  if (SubExprs) C.Deallocate(SubExprs);
-  SubExprs = NewSubExprs;
-  this->NumArgs = NumArgs;
-}
-
 /// getBuiltinCallee - If this is a call to a builtin, return the builtin ID. If
 /// not, return 0.
 unsigned CallExpr::getBuiltinCallee() const {
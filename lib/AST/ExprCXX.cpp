@@ -432,6 +432,25 @@ SourceLocation CXXConstructExpr::getLocEnd() const {
   return End;
 }
 
+CXXOperatorCallExpr *
+CXXOperatorCallExpr::Create(const ASTContext &C, OverloadedOperatorKind Op,
+                            Expr *Fn, ArrayRef<Expr *> Args, QualType Ty,
+                            ExprValueKind VK, SourceLocation OperatorLoc,
+                            bool FPContractable, unsigned MinNumArgs) {
+  unsigned NumArgs = std::max<unsigned>(Args.size(), MinNumArgs);
+  void *Mem = C.Allocate(sizeToAllocate(CXXOperatorCallExprClass, 0, NumArgs),
+                         llvm::alignOf<CXXOperatorCallExpr>());
+  return new (Mem) CXXOperatorCallExpr(Op, Fn, Args, Ty, VK, OperatorLoc,
+                                       FPContractable, MinNumArgs);
+}
+
+CXXOperatorCallExpr *CXXOperatorCallExpr::CreateEmpty(const ASTContext &C,
+                                                      unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CXXOperatorCallExprClass, 0, NumArgs),
+                         llvm::alignOf<CXXOperatorCallExpr>());
+  return new (Mem) CXXOperatorCallExpr(NumArgs, EmptyShell());
+}
+
 SourceRange CXXOperatorCallExpr::getSourceRangeImpl() const {
   OverloadedOperatorKind Kind = getOperator();
   if (Kind == OO_PlusPlus || Kind == OO_MinusMinus) {
@@ -456,6 +475,24 @@ SourceRange CXXOperatorCallExpr::getSourceRangeImpl() const {
   }
 }
 
+CXXMemberCallExpr *CXXMemberCallExpr::Create(const ASTContext &C, Expr *Fn,
+                                             ArrayRef<Expr *> Args,
+                                             QualType Ty, ExprValueKind VK,
+                                             SourceLocation RP,
+                                             unsigned MinNumArgs) {
+  unsigned NumArgs = std::max<unsigned>(Args.size(), MinNumArgs);
+  void *Mem = C.Allocate(sizeToAllocate(CXXMemberCallExprClass, 0, NumArgs),
+                         llvm::alignOf<CXXMemberCallExpr>());
+  return new (Mem) CXXMemberCallExpr(Fn, Args, Ty, VK, RP, MinNumArgs);
+}
+
+CXXMemberCallExpr *CXXMemberCallExpr::CreateEmpty(const ASTContext &C,
+                                                  unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CXXMemberCallExprClass, 0, NumArgs),
+                         llvm::alignOf<CXXMemberCallExpr>());
+  return new (Mem) CXXMemberCallExpr(NumArgs, EmptyShell());
+}
+
 Expr *CXXMemberCallExpr::getImplicitObjectArgument() const {
   const Expr *Callee = getCallee()->IgnoreParens();
   if (const MemberExpr *MemExpr = dyn_cast<MemberExpr>(Callee))
@@ -489,6 +526,27 @@ CXXRecordDecl *CXXMemberCallExpr::getRecordDecl() const {
   return ThisArg->getType()->getAsCXXRecordDecl();
 }
 
+CUDAKernelCallExpr *
+CUDAKernelCallExpr::Create(const ASTContext &C, Expr *Fn, CallExpr *Config,
+                           ArrayRef<Expr *> Args, QualType Ty,
+                           ExprValueKind VK, SourceLocation RP,
+                           unsigned MinNumArgs) {
+  unsigned NumArgs = std::max<unsigned>(Args.size(), MinNumArgs);
+  void *Mem = C.Allocate(sizeToAllocate(CUDAKernelCallExprClass, END_PREARG,
+                                        NumArgs),
+                         llvm::alignOf<CUDAKernelCallExpr>());
+  return new (Mem)
+      CUDAKernelCallExpr(Fn, Config, Args, Ty, VK, RP, MinNumArgs);
+}
+
+CUDAKernelCallExpr *CUDAKernelCallExpr::CreateEmpty(const ASTContext &C,
+                                                    unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CUDAKernelCallExprClass, END_PREARG,
+                                        NumArgs),
+                         llvm::alignOf<CUDAKernelCallExpr>());
+  return new (Mem) CUDAKernelCallExpr(NumArgs, EmptyShell());
+}
+
 
 //===----------------------------------------------------------------------===//
 //  Named casts
@@ -656,6 +714,24 @@ SourceLocation CXXFunctionalCastExpr::getLocEnd() const {
   return RParenLoc.isValid() ? RParenLoc : getSubExpr()->getLocEnd();
 }
 
+UserDefinedLiteral *UserDefinedLiteral::Create(const ASTContext &C, Expr *Fn,
+                                               ArrayRef<Expr *> Args,
+                                               QualType Ty, ExprValueKind VK,
+                                               SourceLocation LitEndLoc,
+                                               SourceLocation SuffixLoc) {
+  void *Mem = C.Allocate(sizeToAllocate(UserDefinedLiteralClass, 0,
+                                        Args.size()),
+                         llvm::alignOf<UserDefinedLiteral>());
+  return new (Mem) UserDefinedLiteral(Fn, Args, Ty, VK, LitEndLoc, SuffixLoc);
+}
+
+UserDefinedLiteral *UserDefinedLiteral::CreateEmpty(const ASTContext &C,
+                                                    unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(UserDefinedLiteralClass, 0, NumArgs),
+                         llvm::alignOf<UserDefinedLiteral>());
+  return new (Mem) UserDefinedLiteral(NumArgs, EmptyShell());
+}
+
 UserDefinedLiteral::LiteralOperatorKind
 UserDefinedLiteral::getLiteralOperatorKind() const {
   if (getNumArgs() == 0)
@@ -716,8 +792,7 @@ CXXBindTemporaryExpr *CXXBindTemporaryExpr::Create(const ASTContext &C,
   return new (C) CXXBindTemporaryExpr(Temp, SubExpr);
 }
 
-CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
-                                               CXXConstructorDecl *Cons,
+CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(CXXConstructorDecl *Cons,
                                                TypeSourceInfo *Type,
                                                ArrayRef<Expr*> Args,
                                                SourceRange ParenOrBraceRange,
@@ -725,7 +800,7 @@ CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
                                                bool ListInitialization,
                                                bool StdInitListInitialization,
                                                bool ZeroInitialization)
-  : CXXConstructExpr(C, CXXTemporaryObjectExprClass, 
+  : CXXConstructExpr(CXXTemporaryObjectExprClass,
                      Type->getType().getNonReferenceType(), 
                      Type->getTypeLoc().getBeginLoc(),
                      Cons, false, Args,
@@ -737,6 +812,32 @@ CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
     Type(Type) {
 }
 
+CXXTemporaryObjectExpr *
+CXXTemporaryObjectExpr::Create(const ASTContext &C, CXXConstructorDecl *Cons,
+                               TypeSourceInfo *Type, ArrayRef<Expr *> Args,
+                               SourceRange ParenOrBraceRange,
+                               bool HadMultipleCandidates,
+                               bool ListInitialization,
+                               bool StdInitListInitialization,
+                               bool ZeroInitialization) {
+  void *Mem = C.Allocate(sizeof(CXXTemporaryObjectExpr) +
+                             Args.size() * sizeof(Stmt *),
+                         llvm::alignOf<CXXTemporaryObjectExpr>());
+  return new (Mem) CXXTemporaryObjectExpr(Cons, Type, Args, ParenOrBraceRange,
+                                          HadMultipleCandidates,
+                                          ListInitialization,
+                                          StdInitListInitialization,
+                                          ZeroInitialization);
+}
+
+CXXTemporaryObjectExpr *
+CXXTemporaryObjectExpr::CreateEmpty(const ASTContext &C, unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeof(CXXTemporaryObjectExpr) +
+                             NumArgs * sizeof(Stmt *),
+                         llvm::alignOf<CXXTemporaryObjectExpr>());
+  return new (Mem) CXXTemporaryObjectExpr(EmptyShell(), NumArgs);
+}
+
 SourceLocation CXXTemporaryObjectExpr::getLocStart() const {
   return Type->getTypeLoc().getBeginLoc();
 }
@@ -759,16 +860,27 @@ CXXConstructExpr *CXXConstructExpr::Create(const ASTContext &C, QualType T,
                                            bool ZeroInitialization,
                                            ConstructionKind ConstructKind,
                                            SourceRange ParenOrBraceRange) {
-  return new (C) CXXConstructExpr(C, CXXConstructExprClass, T, Loc,
-                                  Ctor, Elidable, Args,
-                                  HadMultipleCandidates, ListInitialization,
-                                  StdInitListInitialization,
-                                  ZeroInitialization, ConstructKind,
-                                  ParenOrBraceRange);
-}
-
-CXXConstructExpr::CXXConstructExpr(const ASTContext &C, StmtClass SC,
-                                   QualType T, SourceLocation Loc,
+  void *Mem = C.Allocate(sizeof(CXXConstructExpr) +
+                             Args.size() * sizeof(Stmt *),
+                         llvm::alignOf<CXXConstructExpr>());
+  return new (Mem) CXXConstructExpr(CXXConstructExprClass, T, Loc,
+                                    Ctor, Elidable, Args,
+                                    HadMultipleCandidates, ListInitialization,
+                                    StdInitListInitialization,
+                                    ZeroInitialization, ConstructKind,
+                                    ParenOrBraceRange);
+}
+
+CXXConstructExpr *CXXConstructExpr::CreateEmpty(const ASTContext &C,
+                                                unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeof(CXXConstructExpr) + NumArgs * sizeof(Stmt *),
+                         llvm::alignOf<CXXConstructExpr>());
+  return new (Mem) CXXConstructExpr(CXXConstructExprClass, EmptyShell(),
+                                    NumArgs);
+}
+
+CXXConstructExpr::CXXConstructExpr(StmtClass SC, QualType T,
+                                   SourceLocation Loc,
                                    CXXConstructorDecl *Ctor,
                                    bool Elidable,
                                    ArrayRef<Expr*> Args,
@@ -783,31 +895,41 @@ CXXConstructExpr::CXXConstructExpr(const ASTContext &C, StmtClass SC,
          T->isInstantiationDependentType(),
          T->containsUnexpandedParameterPack()),
     Constructor(Ctor), Loc(Loc), ParenOrBraceRange(ParenOrBraceRange),
-    NumArgs(Args.size()),
-    Elidable(Elidable), HadMultipleCandidates(HadMultipleCandidates),
-    ListInitialization(ListInitialization),
-    StdInitListInitialization(StdInitListInitialization),
-    ZeroInitialization(ZeroInitialization),
-    ConstructKind(ConstructKind), Args(nullptr)
+    NumArgs(Args.size())
 {
-  if (NumArgs) {
-    this->Args = new (C) Stmt*[Args.size()];
-    
-    for (unsigned i = 0; i != Args.size(); ++i) {
-      assert(Args[i] && "NULL argument in CXXConstructExpr");
+  CXXConstructExprBits.Elidable = Elidable;
+  CXXConstructExprBits.HadMultipleCandidates = HadMultipleCandidates;
+  CXXConstructExprBits.ListInitialization = ListInitialization;
+  CXXConstructExprBits.StdInitListInitialization = StdInitListInitialization;
+  CXXConstructExprBits.ZeroInitialization = ZeroInitialization;
+  CXXConstructExprBits.ConstructKind = ConstructKind;
+
+  Stmt **TrailingArgs = getTrailingArgs();
+  for (unsigned i = 0; i != Args.size(); ++i) {
+    assert(Args[i] && "NULL argument in CXXConstructExpr");
+
+    if (Args[i]->isValueDependent())
+      ExprBits.ValueDependent = true;
+    if (Args[i]->isInstantiationDependent())
+      ExprBits.InstantiationDependent = true;
+    if (Args[i]->containsUnexpandedParameterPack())
+      ExprBits.ContainsUnexpandedParameterPack = true;
 
-      if (Args[i]->isValueDependent())
-        ExprBits.ValueDependent = true;
-      if (Args[i]->isInstantiationDependent())
-        ExprBits.InstantiationDependent = true;
-      if (Args[i]->containsUnexpandedParameterPack())
-        ExprBits.ContainsUnexpandedParameterPack = true;
-  
-      this->Args[i] = Args[i];
-    }
+    TrailingArgs[i] = Args[i];
   }
 }
 
+CXXConstructExpr::CXXConstructExpr(StmtClass SC, EmptyShell Empty,
+                                   unsigned NumArgs)
+  : Expr(SC, Empty), Constructor(nullptr), NumArgs(NumArgs) {
+  CXXConstructExprBits.Elidable = false;
+  CXXConstructExprBits.HadMultipleCandidates = false;
+  CXXConstructExprBits.ListInitialization = false;
+  CXXConstructExprBits.StdInitListInitialization = false;
+  CXXConstructExprBits.ZeroInitialization = false;
+  CXXConstructExprBits.ConstructKind = 0;
+}
+
 LambdaCapture::LambdaCapture(SourceLocation Loc, bool Implicit,
                              LambdaCaptureKind Kind, VarDecl *Var,
                              SourceLocation EllipsisLoc)
@@ -38,6 +38,8 @@
 #include "clang/AST/ASTDiagnostic.h"
 #include "clang/AST/ASTLambda.h"
 #include "clang/AST/CharUnits.h"
+#include "clang/AST/ConstexprCallCache.h"
+#include "clang/AST/ConstexprInterpreter.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/AST/StmtVisitor.h"
@@ -480,6 +482,20 @@ namespace {
     /// \brief Whether or not we're currently speculatively evaluating.
     bool IsSpeculativelyEvaluating;
 
+    /// \brief The number of diagnostics, side-effects and accesses to the
+    /// object under construction seen so far. If evaluating a call does not
+    /// change this count, its result depends only on its arguments.
+    unsigned NumUncacheableEvents;
+
+    /// \brief Whether the bytecode interpreter has given up on a call during
+    /// this evaluation. If so, it is not offered any more calls, since the
+    /// calls nested in the one it gave up on would fail in the same way.
+    bool ConstexprInterpreterGaveUp;
+
+    /// \brief The greatest call stack depth at which a call has been made
+    /// during this evaluation.
+    unsigned DeepestCall;
+
     enum EvaluationMode {
       /// Evaluate as a constant expression. Stop if we find that the expression
       /// is not a constant expression.
@@ -545,7 +561,8 @@ namespace {
         EvaluatingDecl((const ValueDecl *)nullptr),
         EvaluatingDeclValue(nullptr), HasActiveDiagnostic(false),
         HasFoldFailureDiagnostic(false), IsSpeculativelyEvaluating(false),
-        EvalMode(Mode) {}
+        NumUncacheableEvents(0), ConstexprInterpreterGaveUp(false),
+        DeepestCall(0), EvalMode(Mode) {}
 
     void setEvaluatingDecl(APValue::LValueBase Base, APValue &Value) {
       EvaluatingDecl = Base;
@@ -564,8 +581,10 @@ namespace {
         FFDiag(Loc, diag::note_constexpr_call_limit_exceeded);
         return false;
       }
-      if (CallStackDepth <= getLangOpts().ConstexprCallDepth)
+      if (CallStackDepth <= getLangOpts().ConstexprCallDepth) {
+        DeepestCall = std::max(DeepestCall, CallStackDepth);
         return true;
+      }
       FFDiag(Loc, diag::note_constexpr_depth_limit_exceeded)
         << getLangOpts().ConstexprCallDepth;
       return false;
@@ -581,6 +600,10 @@ namespace {
       return (Frame->Index == CallIndex) ? Frame : nullptr;
     }
 
+    /// \brief Note that the result of the current evaluation depends on
+    /// something other than the arguments of the calls being evaluated.
+    void noteUncacheable() { ++NumUncacheableEvents; }
+
     bool nextStep(const Stmt *S) {
       if (!StepsLeft) {
         FFDiag(S->getLocStart(), diag::note_constexpr_step_limit_exceeded);
@@ -655,12 +678,14 @@ namespace {
     FFDiag(SourceLocation Loc,
           diag::kind DiagId = diag::note_invalid_subexpr_in_const_expr,
           unsigned ExtraNotes = 0) {
+      noteUncacheable();
       return Diag(Loc, DiagId, ExtraNotes, false);
     }
     
     OptionalDiagnostic FFDiag(const Expr *E, diag::kind DiagId
                               = diag::note_invalid_subexpr_in_const_expr,
                             unsigned ExtraNotes = 0) {
+      noteUncacheable();
       if (EvalStatus.Diag)
         return Diag(E->getExprLoc(), DiagId, ExtraNotes, /*IsCCEDiag*/false);
       HasActiveDiagnostic = false;
@@ -675,6 +700,7 @@ namespace {
     OptionalDiagnostic CCEDiag(SourceLocation Loc, diag::kind DiagId
                                  = diag::note_invalid_subexpr_in_const_expr,
                                unsigned ExtraNotes = 0) {
+      noteUncacheable();
       // Don't override a previous diagnostic. Don't bother collecting
       // diagnostics if we're evaluating for overflow.
       if (!EvalStatus.Diag || !EvalStatus.Diag->empty()) {
@@ -725,6 +751,7 @@ namespace {
     /// Note that we have had a side-effect, and determine whether we should
     /// keep evaluating.
     bool noteSideEffect() {
+      noteUncacheable();
       EvalStatus.HasSideEffects = true;
       return keepEvaluatingAfterSideEffect();
     }
@@ -751,6 +778,7 @@ namespace {
     /// that we can evaluate past it (such as signed overflow or floating-point
     /// division by zero.)
     bool noteUndefinedBehavior() {
+      noteUncacheable();
       EvalStatus.HasUndefinedBehavior = true;
       return keepEvaluatingAfterUndefinedBehavior();
     }
@@ -795,6 +823,7 @@ namespace {
       // subexpression implies that a side-effect has potentially happened. We
       // skip setting the HasSideEffects flag to true until we decide to
       // continue evaluating after that point, which happens here.
+      noteUncacheable();
       bool KeepGoing = keepEvaluatingAfterFailure();
       EvalStatus.HasSideEffects |= KeepGoing;
       return KeepGoing;
@@ -2157,6 +2186,7 @@ static bool evaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl.dyn_cast<const ValueDecl*>() == VD) {
+    Info.noteUncacheable();
     Result = Info.EvaluatingDeclValue;
     return true;
   }
@@ -2836,6 +2866,8 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
           Info.Note(MTE->getExprLoc(), diag::note_constexpr_temporary_here);
           return CompleteObject();
         }
+        if (VD && VD->getCanonicalDecl() == ED->getCanonicalDecl())
+          Info.noteUncacheable();
 
         BaseVal = Info.Ctx.getMaterializedTemporaryValue(MTE, false);
         assert(BaseVal && "got reference to unevaluated temporary");
@@ -2866,6 +2898,7 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
   // and this doesn't do quite the right thing for const subobjects of the
   // object under construction.
   if (LVal.getLValueBase() == Info.EvaluatingDecl) {
+    Info.noteUncacheable();
     BaseType = Info.Ctx.getCanonicalType(BaseType);
     BaseType.removeLocalConst();
   }
@@ -3950,18 +3983,34 @@ static bool EvaluateArgs(ArrayRef<const Expr*> Args, ArgVector &ArgValues,
   return Success;
 }
 
-/// Evaluate a function call.
-static bool HandleFunctionCall(SourceLocation CallLoc,
+/// Evaluate the body of a called function, given its argument values.
+static bool HandleFunctionBody(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
-                               ArrayRef<const Expr*> Args, const Stmt *Body,
-                               EvalInfo &Info, APValue &Result,
-                               const LValue *ResultSlot) {
-  ArgVector ArgValues(Args.size());
-  if (!EvaluateArgs(Args, ArgValues, Info))
-    return false;
-
-  if (!Info.CheckCallLimit(CallLoc))
-    return false;
+                               ArrayRef<const Expr*> Args, ArgVector &ArgValues,
+                               const Stmt *Body, EvalInfo &Info,
+                               APValue &Result, const LValue *ResultSlot) {
+  // Calls to simple functions can be evaluated by the bytecode interpreter.
+  // It gives up on anything that would need a diagnostic, so that the call
+  // is evaluated again below and diagnosed in the usual way.
+  if (Info.getLangOpts().ConstexprBytecode && !This &&
+      !Info.checkingPotentialConstantExpression() &&
+      !Info.ConstexprInterpreterGaveUp) {
+    unsigned NestedDepth;
+    switch (Info.Ctx.getConstexprInterpreter().evaluateCall(
+        Callee, ArgValues,
+        Info.getLangOpts().ConstexprCallDepth - Info.CallStackDepth,
+        Info.StepsLeft, NestedDepth, Result)) {
+    case ConstexprInterpreter::CR_Evaluated:
+      Info.DeepestCall =
+          std::max(Info.DeepestCall, Info.CallStackDepth + NestedDepth);
+      return true;
+    case ConstexprInterpreter::CR_Unsupported:
+      break;
+    case ConstexprInterpreter::CR_GaveUp:
+      Info.ConstexprInterpreterGaveUp = true;
+      break;
+    }
+  }
 
   CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
 
@@ -4000,6 +4049,64 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   return ESR == ESR_Returned;
 }
 
+/// Evaluate a function call.
+static bool HandleFunctionCall(SourceLocation CallLoc,
+                               const FunctionDecl *Callee, const LValue *This,
+                               ArrayRef<const Expr*> Args, const Stmt *Body,
+                               EvalInfo &Info, APValue &Result,
+                               const LValue *ResultSlot) {
+  ArgVector ArgValues(Args.size());
+  if (!EvaluateArgs(Args, ArgValues, Info))
+    return false;
+
+  if (!Info.CheckCallLimit(CallLoc))
+    return false;
+
+  // The results of calls with integer arguments are remembered, so that a
+  // pure function called again with the same arguments is not evaluated
+  // again. A result is only remembered if nothing but the arguments could
+  // have affected it: no diagnostics, side-effects or accesses to the object
+  // under construction. The steps the call took and the depth of the calls it
+  // made are remembered too, and charged again whenever the result is reused,
+  // so that the cache does not let an evaluation exceed the limits.
+  llvm::FoldingSetNodeID CallKey;
+  if (!Info.getLangOpts().ConstexprCallCache || This ||
+      Info.checkingPotentialConstantExpression() ||
+      Info.checkingForOverflow() ||
+      !ConstexprCallCache::getKey(Callee, ArgValues, CallKey))
+    return HandleFunctionBody(CallLoc, Callee, This, Args, ArgValues, Body,
+                              Info, Result, ResultSlot);
+
+  // If reusing the result would exceed a limit, evaluate the call instead,
+  // so that the limit is diagnosed where it is reached.
+  ConstexprCallCache &Cache = Info.Ctx.getConstexprCallCache();
+  if (const ConstexprCallCache::Entry *Cached = Cache.lookup(CallKey)) {
+    if (Cached->Steps <= Info.StepsLeft &&
+        Info.CallStackDepth + Cached->Depth <=
+            Info.getLangOpts().ConstexprCallDepth) {
+      Info.StepsLeft -= Cached->Steps;
+      Info.DeepestCall =
+          std::max(Info.DeepestCall, Info.CallStackDepth + Cached->Depth);
+      Result = Cached->Result;
+      return true;
+    }
+  }
+
+  unsigned NumEvents = Info.NumUncacheableEvents;
+  unsigned StepsLeft = Info.StepsLeft;
+  unsigned CallerDeepestCall = Info.DeepestCall;
+  Info.DeepestCall = Info.CallStackDepth;
+  bool Success = HandleFunctionBody(CallLoc, Callee, This, Args, ArgValues,
+                                    Body, Info, Result, ResultSlot);
+  unsigned Depth = Info.DeepestCall - Info.CallStackDepth;
+  Info.DeepestCall = std::max(CallerDeepestCall, Info.DeepestCall);
+  if (!Success)
+    return false;
+  if (Info.NumUncacheableEvents == NumEvents)
+    Cache.insert(CallKey, Result, StepsLeft - Info.StepsLeft, Depth);
+  return true;
+}
+
 /// Evaluate a constructor call.
 static bool HandleConstructorCall(const Expr *E, const LValue &This,
                                   APValue *ArgValues,
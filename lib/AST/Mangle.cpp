@@ -183,6 +183,55 @@ void MangleContext::mangleName(const NamedDecl *D, raw_ostream &Out) {
   Out << ((TI.getPointerWidth(0) / 8) * ArgWords);
 }
 
+namespace {
+/// The kinds of names kept by the cached mangler entry points.
+enum CachedNameKind {
+  CNK_RTTIName,
+  CNK_TypeName
+};
+}
+
+StringRef MangleContext::cacheName(std::pair<const void *, unsigned> Key,
+                                   StringRef Name) {
+  char *Mem = CachedNameAllocator.Allocate<char>(Name.size());
+  std::copy(Name.begin(), Name.end(), Mem);
+  return CachedNames[Key] = StringRef(Mem, Name.size());
+}
+
+StringRef MangleContext::getCachedTypeName(QualType T, unsigned Kind,
+                                           SmallVectorImpl<char> &Buffer) {
+  // Only types with external linkage are cached: the names of local and
+  // unnamed types can depend on the function being emitted.
+  QualType CanonT = T.getCanonicalType();
+  bool Cacheable = getASTContext().getLangOpts().MangledNameCache &&
+                   !CanonT->isInstantiationDependentType() &&
+                   CanonT->getLinkage() == ExternalLinkage;
+  std::pair<const void *, unsigned> Key(CanonT.getAsOpaquePtr(), Kind);
+  if (Cacheable) {
+    auto Pos = CachedNames.find(Key);
+    if (Pos != CachedNames.end())
+      return Pos->second;
+  }
+
+  Buffer.clear();
+  llvm::raw_svector_ostream Out(Buffer);
+  if (Kind == CNK_RTTIName)
+    mangleCXXRTTIName(T, Out);
+  else
+    mangleTypeName(T, Out);
+  return Cacheable ? cacheName(Key, Out.str()) : Out.str();
+}
+
+StringRef MangleContext::getMangledCXXRTTIName(QualType T,
+                                               SmallVectorImpl<char> &Buffer) {
+  return getCachedTypeName(T, CNK_RTTIName, Buffer);
+}
+
+StringRef MangleContext::getMangledTypeName(QualType T,
+                                            SmallVectorImpl<char> &Buffer) {
+  return getCachedTypeName(T, CNK_TypeName, Buffer);
+}
+
 void MangleContext::mangleGlobalBlock(const BlockDecl *BD,
                                       const NamedDecl *ID,
                                       raw_ostream &Out) {
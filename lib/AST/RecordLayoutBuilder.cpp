@@ -2916,6 +2916,25 @@ void MicrosoftRecordLayoutBuilder::computeVtorDispSet(
   }
 }
 
+/// Could laying out the given record produce a diagnostic? The warnings
+/// about the record as a whole are issued at its location, and those about
+/// its fields at theirs, where pragmas may have enabled them separately.
+static bool hasLayoutDiagnostics(DiagnosticsEngine &Diags,
+                                 const RecordDecl *D) {
+  SourceLocation Loc = D->getLocation();
+  if (!Diags.isIgnored(diag::warn_padded_struct_size, Loc) ||
+      !Diags.isIgnored(diag::warn_unnecessary_packed, Loc))
+    return true;
+  for (const FieldDecl *FD : D->fields()) {
+    SourceLocation FieldLoc = FD->getLocation();
+    if (!Diags.isIgnored(diag::warn_padded_struct_field, FieldLoc) ||
+        !Diags.isIgnored(diag::warn_padded_struct_anon_field, FieldLoc) ||
+        !Diags.isIgnored(diag::warn_unnecessary_packed, FieldLoc))
+      return true;
+  }
+  return false;
+}
+
 /// getASTRecordLayout - Get or compute information about the layout of the
 /// specified record (struct/union/class), which indicates its size and field
 /// position information.
@@ -2940,6 +2959,18 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
   const ASTRecordLayout *Entry = ASTRecordLayouts[D];
   if (Entry) return *Entry;
 
+  // If the layout was computed when an AST file containing the record was
+  // built, use it, unless it is to be dumped or the layout builder would
+  // have warnings to issue about it.
+  if (ExternalSource && !getLangOpts().DumpRecordLayouts &&
+      !hasLayoutDiagnostics(getDiagnostics(), D)) {
+    if (const ASTRecordLayout *Stored =
+            ExternalSource->getStoredRecordLayout(D)) {
+      ASTRecordLayouts[D] = Stored;
+      return *Stored;
+    }
+  }
+
   const ASTRecordLayout *NewEntry = nullptr;
 
   if (isMsLayout(*this)) {
@@ -21,6 +21,7 @@
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Bitcode/BitcodeWriterPass.h"
 #include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/RegAllocRegistry.h"
 #include "llvm/CodeGen/SchedulerRegistry.h"
 #include "llvm/IR/DataLayout.h"
@@ -48,6 +49,7 @@
 #include "llvm/Transforms/ObjCARC.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Scalar/GVN.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/SymbolRewriter.h"
 #include <memory>
 using namespace clang;
@@ -95,6 +97,14 @@ private:
   bool AddEmitPasses(legacy::PassManager &CodeGenPasses, BackendAction Action,
                      raw_pwrite_stream &OS);
 
+  /// Split the module into partitions and generate object code for each of
+  /// them on a thread of its own (-fparallel-codegen=).
+  void EmitPartitionedObject(raw_pwrite_stream &OS);
+
+  /// Check whether the module can be compiled by the code generator alone,
+  /// without the passes CreatePasses would set up (-fminimal-codegen-pipeline).
+  bool canUseMinimalPipeline(BackendAction Action) const;
+
 public:
   EmitAssemblyHelper(DiagnosticsEngine &_Diags, const CodeGenOptions &CGOpts,
                      const clang::TargetOptions &TOpts,
@@ -127,6 +137,17 @@ private:
   const LangOptions &LangOpts;
 };
 
+// A pass manager that only counts the passes added to it, used to find out
+// whether a PassManagerBuilder would add any passes.
+class PassCounter : public legacy::PassManagerBase {
+public:
+  unsigned NumPasses = 0;
+  void add(Pass *P) override {
+    ++NumPasses;
+    delete P;
+  }
+};
+
 }
 
 static void addObjCARCAPElimPass(const PassManagerBuilder &Builder, PassManagerBase &PM) {
@@ -637,6 +658,96 @@ bool EmitAssemblyHelper::AddEmitPasses(legacy::PassManager &CodeGenPasses,
   return true;
 }
 
+void EmitAssemblyHelper::EmitPartitionedObject(raw_pwrite_stream &OS) {
+  SmallVector<raw_pwrite_stream *, 8> Streams;
+  std::vector<std::unique_ptr<raw_fd_ostream>> PartitionStreams;
+  Streams.push_back(&OS);
+  for (const std::string &Path : CodeGenOpts.ParallelCodeGenOutputs) {
+    std::error_code EC;
+    PartitionStreams.emplace_back(
+        new raw_fd_ostream(Path, EC, sys::fs::F_None));
+    if (EC) {
+      Diags.Report(diag::err_fe_unable_to_open_output) << Path << EC.message();
+      return;
+    }
+    Streams.push_back(PartitionStreams.back().get());
+  }
+
+  // Each partition is compiled in a context of its own, by a target machine
+  // of its own that is configured like ours.
+  auto CreateTargetMachine = [this]() {
+    return std::unique_ptr<TargetMachine>(TM->getTarget().createTargetMachine(
+        TM->getTargetTriple().str(), TM->getTargetCPU(),
+        TM->getTargetFeatureString(), TM->Options, TM->getRelocationModel(),
+        TM->getCodeModel(), TM->getOptLevel()));
+  };
+
+  // The module still belongs to our caller, so split a copy of it. Local
+  // symbols are kept in the same partition as their users, so that the
+  // objects do not export anything that the module would not.
+  PrettyStackTraceString CrashInfo("Parallel code generation");
+  splitCodeGen(CloneModule(TheModule), Streams, /*BCOSs=*/None,
+               CreateTargetMachine, TargetMachine::CGFT_ObjectFile,
+               /*PreserveLocals=*/true);
+}
+
+bool EmitAssemblyHelper::canUseMinimalPipeline(BackendAction Action) const {
+  if (!CodeGenOpts.MinimalCodeGenPipeline ||
+      CodeGenOpts.OptimizationLevel != 0)
+    return false;
+
+  if (Action != Backend_EmitAssembly && Action != Backend_EmitObj &&
+      Action != Backend_EmitMCNull)
+    return false;
+  if (!CodeGenOpts.ParallelCodeGenOutputs.empty())
+    return false;
+
+  // These add passes even at -O0.
+  if (!LangOpts.Sanitize.empty() || CodeGenOpts.SanitizeCoverageType ||
+      CodeGenOpts.SanitizeCoverageIndirectCalls ||
+      CodeGenOpts.SanitizeCoverageTraceBB ||
+      CodeGenOpts.SanitizeCoverageTraceCmp ||
+      CodeGenOpts.SanitizeCoverageTraceDiv ||
+      CodeGenOpts.SanitizeCoverageTraceGep ||
+      CodeGenOpts.SanitizeCoverage8bitCounters ||
+      CodeGenOpts.SanitizeCoverageTracePC ||
+      CodeGenOpts.SanitizeCoverageTracePCGuard)
+    return false;
+  if (!CodeGenOpts.DisableGCov &&
+      (CodeGenOpts.EmitGcovArcs || CodeGenOpts.EmitGcovNotes))
+    return false;
+  if (CodeGenOpts.hasProfileClangInstr() || CodeGenOpts.hasProfileIRInstr() ||
+      CodeGenOpts.hasProfileIRUse() || !CodeGenOpts.SampleProfileFile.empty())
+    return false;
+  if (!CodeGenOpts.RewriteMapFiles.empty())
+    return false;
+
+  // Plugins can register passes with every PassManagerBuilder, including
+  // at -O0, and there is no way to ask for them. At -O0 a builder adds a
+  // barrier pass if it has any extensions, global or its own. So if giving
+  // a builder an extension of its own does not add a pass, it already had
+  // global ones.
+  PassManagerBuilder Plain, Extended;
+  Extended.addExtension(
+      PassManagerBuilder::EP_OptimizerLast,
+      [](const PassManagerBuilder &, legacy::PassManagerBase &) {});
+  PassCounter PlainPasses, ExtendedPasses;
+  Plain.OptLevel = Extended.OptLevel = 0;
+  Plain.populateModulePassManager(PlainPasses);
+  Extended.populateModulePassManager(ExtendedPasses);
+  if (ExtendedPasses.NumPasses == PlainPasses.NumPasses)
+    return false;
+
+  // The always-inliner is the only optimization that runs at -O0, so we can
+  // do without it if there is nothing for it to inline.
+  if (CodeGenOpts.getInlining() != CodeGenOptions::NoInlining)
+    for (const Function &F : *TheModule)
+      if (!F.isDeclaration() && F.hasFnAttribute(Attribute::AlwaysInline))
+        return false;
+
+  return true;
+}
+
 void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
                                       std::unique_ptr<raw_pwrite_stream> OS) {
   TimeRegion Region(llvm::TimePassesIsEnabled ? &CodeGenerationTime : nullptr);
@@ -653,6 +764,28 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
   if (TM)
     TheModule->setDataLayout(TM->createDataLayout());
 
+  // Without any IR passes to run, there is no need for a pass manager
+  // builder, a call graph for the always-inliner, or a separate verifier run
+  // over every function; the few function passes that must still run at -O0
+  // are scheduled alongside the code generator.
+  if (UsesCodeGen && canUseMinimalPipeline(Action)) {
+    legacy::PassManager CodeGenPasses;
+    CodeGenPasses.add(
+        createTargetTransformInfoWrapperPass(getTargetIRAnalysis()));
+    if (!CodeGenOpts.DisableLLVMPasses) {
+      TM->addEarlyAsPossiblePasses(CodeGenPasses);
+      CodeGenPasses.add(createAddDiscriminatorsPass());
+    }
+    if (!AddEmitPasses(CodeGenPasses, Action, *OS))
+      return;
+
+    cl::PrintOptionValues();
+
+    PrettyStackTraceString CrashInfo("Code generation");
+    CodeGenPasses.run(*TheModule);
+    return;
+  }
+
   legacy::PassManager PerModulePasses;
   PerModulePasses.add(
       createTargetTransformInfoWrapperPass(getTargetIRAnalysis()));
@@ -667,6 +800,13 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
   CodeGenPasses.add(
       createTargetTransformInfoWrapperPass(getTargetIRAnalysis()));
 
+  // With -fparallel-codegen=, the code generator is run on the partitions of
+  // the optimized module rather than by CodeGenPasses. It does not get our
+  // TargetLibraryInfo, but calls to unavailable library functions are
+  // already marked nobuiltin, which is all that instruction selection needs.
+  bool Partitioned = Action == Backend_EmitObj &&
+                     !CodeGenOpts.ParallelCodeGenOutputs.empty();
+
   switch (Action) {
   case Backend_EmitNothing:
     break;
@@ -683,6 +823,12 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
     break;
 
   default:
+    if (Partitioned) {
+      // AddEmitPasses would run this as part of the code generator.
+      if (CodeGenOpts.OptimizationLevel > 0)
+        PerModulePasses.add(createObjCARCContractPass());
+      break;
+    }
     if (!AddEmitPasses(CodeGenPasses, Action, *OS))
       return;
   }
@@ -708,6 +854,11 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
     PerModulePasses.run(*TheModule);
   }
 
+  if (Partitioned) {
+    EmitPartitionedObject(*OS);
+    return;
+  }
+
   {
     PrettyStackTraceString CrashInfo("Code generation");
     CodeGenPasses.run(*TheModule);
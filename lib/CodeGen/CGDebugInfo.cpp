@@ -47,6 +47,7 @@ using namespace clang::CodeGen;
 CGDebugInfo::CGDebugInfo(CodeGenModule &CGM)
     : CGM(CGM), DebugKind(CGM.getCodeGenOpts().getDebugInfo()),
       DebugTypeExtRefs(CGM.getCodeGenOpts().DebugTypeExtRefs),
+      DebugCtorHoming(CGM.getCodeGenOpts().DebugCtorHoming),
       DBuilder(CGM.getModule()) {
   for (const auto &KV : CGM.getCodeGenOpts().DebugPrefixMap)
     DebugPrefixMap[KV.first] = KV.second;
@@ -689,8 +690,9 @@ static SmallString<256> getUniqueTagTypeName(const TagType *Ty,
 
   // TODO: This is using the RTTI name. Is there a better way to get
   // a unique string for a type?
-  llvm::raw_svector_ostream Out(FullName);
-  CGM.getCXXABI().getMangleContext().mangleCXXRTTIName(QualType(Ty, 0), Out);
+  SmallString<256> Buffer;
+  FullName = CGM.getCXXABI().getMangleContext().getMangledCXXRTTIName(
+      QualType(Ty, 0), Buffer);
   return FullName;
 }
 
@@ -1700,8 +1702,29 @@ static bool isClassOrMethodDLLImport(const CXXRecordDecl *RD) {
   return false;
 }
 
+/// Can the full description of the class be left to the translation units
+/// that emit one of its constructors? That is the case when no object of
+/// the class can be created without calling a constructor that is not
+/// trivial or constexpr.
+static bool canUseCtorHoming(const CXXRecordDecl *RD) {
+  if (RD->isLambda() || RD->isAggregate() ||
+      RD->hasTrivialDefaultConstructor() ||
+      RD->hasConstexprNonCopyMoveConstructor())
+    return false;
+  // The type is only emitted with a constructor that creates an object from
+  // scratch. Without one, every object would be copied or moved from one
+  // that does not exist, and the type would never be emitted at all.
+  if (llvm::none_of(RD->ctors(), [](const CXXConstructorDecl *Ctor) {
+        return !Ctor->isDeleted() && !Ctor->isCopyOrMoveConstructor();
+      }))
+    return false;
+  // As with vtable homing, Microsoft debuggers need the type in each DLL.
+  return !isClassOrMethodDLLImport(RD);
+}
+
 static bool shouldOmitDefinition(codegenoptions::DebugInfoKind DebugKind,
-                                 bool DebugTypeExtRefs, const RecordDecl *RD,
+                                 bool DebugTypeExtRefs, bool DebugCtorHoming,
+                                 const RecordDecl *RD,
                                  const LangOptions &LangOpts) {
   if (DebugTypeExtRefs && isDefinedInClangModule(RD->getDefinition()))
     return true;
@@ -1739,11 +1762,23 @@ static bool shouldOmitDefinition(codegenoptions::DebugInfoKind DebugKind,
                                   CXXDecl->method_end()))
     return true;
 
+  // Only emit complete debug info for a class that cannot be created without
+  // calling a constructor when one of its constructors is emitted.
+  if (DebugCtorHoming && CXXDecl->hasDefinition() &&
+      canUseCtorHoming(CXXDecl->getDefinition()))
+    return true;
+
   return false;
 }
 
+void CGDebugInfo::completeConstructedClass(const CXXRecordDecl *RD) {
+  if (DebugCtorHoming && canUseCtorHoming(RD))
+    completeClassData(RD);
+}
+
 void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
-  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD, CGM.getLangOpts()))
+  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs, DebugCtorHoming, RD,
+                           CGM.getLangOpts()))
     return;
 
   QualType Ty = CGM.getContext().getRecordType(RD);
@@ -1755,8 +1790,8 @@ void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
 llvm::DIType *CGDebugInfo::CreateType(const RecordType *Ty) {
   RecordDecl *RD = Ty->getDecl();
   llvm::DIType *T = cast_or_null<llvm::DIType>(getTypeOrNull(QualType(Ty, 0)));
-  if (T || shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD,
-                                CGM.getLangOpts())) {
+  if (T || shouldOmitDefinition(DebugKind, DebugTypeExtRefs, DebugCtorHoming,
+                                RD, CGM.getLangOpts())) {
     if (!T)
       T = getOrCreateRecordFwdDecl(Ty, getDeclContextDescriptor(RD));
     return T;
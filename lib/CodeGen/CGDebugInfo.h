@@ -55,6 +55,7 @@ class CGDebugInfo {
   CodeGenModule &CGM;
   const codegenoptions::DebugInfoKind DebugKind;
   bool DebugTypeExtRefs;
+  bool DebugCtorHoming;
   llvm::DIBuilder DBuilder;
   llvm::DICompileUnit *TheCU = nullptr;
   ModuleMap *ClangModuleMap = nullptr;
@@ -387,6 +388,10 @@ public:
   void completeRequiredType(const RecordDecl *RD);
   void completeClassData(const RecordDecl *RD);
 
+  /// Emit the full description of a class whose constructor is being
+  /// emitted, if it was left out elsewhere because of constructor homing.
+  void completeConstructedClass(const CXXRecordDecl *RD);
+
   void completeTemplateDefinition(const ClassTemplateSpecializationDecl &SD);
 
 private:
@@ -15,10 +15,16 @@
 #include "CodeGenFunction.h"
 #include "CodeGenModule.h"
 #include "clang/AST/CXXInheritance.h"
+#include "clang/AST/Mangle.h"
 #include "clang/AST/RecordLayout.h"
+#include "clang/Basic/SourceManager.h"
 #include "clang/CodeGen/CGFunctionInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include <algorithm>
 #include <cstdio>
@@ -733,9 +739,17 @@ CodeGenModule::getVTableLinkage(const CXXRecordDecl *RD) {
         return llvm::GlobalVariable::ExternalLinkage;
 
       case TSK_ImplicitInstantiation:
-        return !Context.getLangOpts().AppleKext ?
-                 llvm::GlobalVariable::LinkOnceODRLinkage :
-                 llvm::Function::InternalLinkage;
+        if (Context.getLangOpts().AppleKext)
+          return llvm::Function::InternalLinkage;
+        switch (VTables.getVTableOwnership(RD)) {
+        case CodeGenVTables::VTableOwnerUnknown:
+          break;
+        case CodeGenVTables::VTableOwnedHere:
+          return llvm::GlobalVariable::WeakODRLinkage;
+        case CodeGenVTables::VTableOwnedElsewhere:
+          return llvm::GlobalVariable::AvailableExternallyLinkage;
+        }
+        return llvm::GlobalVariable::LinkOnceODRLinkage;
 
       case TSK_ExplicitInstantiationDefinition:
         return !Context.getLangOpts().AppleKext ?
@@ -769,6 +783,17 @@ CodeGenModule::getVTableLinkage(const CXXRecordDecl *RD) {
     case TSK_Undeclared:
     case TSK_ExplicitSpecialization:
     case TSK_ImplicitInstantiation:
+      // The translation unit that -fvtable-owners assigns the vtable to must
+      // keep it, since the others only refer to it. They can still emit an
+      // available_externally copy for optimization.
+      switch (VTables.getVTableOwnership(RD)) {
+      case CodeGenVTables::VTableOwnerUnknown:
+        break;
+      case CodeGenVTables::VTableOwnedHere:
+        return NonDiscardableODRLinkage;
+      case CodeGenVTables::VTableOwnedElsewhere:
+        return llvm::GlobalVariable::AvailableExternallyLinkage;
+      }
       return DiscardableODRLinkage;
 
     case TSK_ExplicitInstantiationDeclaration:
@@ -833,22 +858,121 @@ bool CodeGenVTables::isVTableExternal(const CXXRecordDecl *RD) {
     return true;
 
   // Otherwise, if the class is an instantiated template, the
-  // vtable must be defined here.
-  if (TSK == TSK_ImplicitInstantiation ||
-      TSK == TSK_ExplicitInstantiationDefinition)
+  // vtable must be defined here, unless -fvtable-owners says that
+  // another translation unit defines it.
+  if (TSK == TSK_ImplicitInstantiation)
+    return getVTableOwnership(RD) == VTableOwnedElsewhere;
+  if (TSK == TSK_ExplicitInstantiationDefinition)
     return false;
 
   // Otherwise, if the class doesn't have a key function (possibly
-  // anymore), the vtable must be defined here.
+  // anymore), the vtable must be defined here, again unless it is
+  // assigned to another translation unit.
   const CXXMethodDecl *keyFunction = CGM.getContext().getCurrentKeyFunction(RD);
   if (!keyFunction)
-    return false;
+    return getVTableOwnership(RD) == VTableOwnedElsewhere;
 
   // Otherwise, if we don't have a definition of the key function, the
   // vtable must be defined somewhere else.
   return !keyFunction->hasBody();
 }
 
+/// Read the -fvtable-owners file. Each line names a vtable by its mangled
+/// name, followed by whitespace and the path of the main source file of the
+/// translation unit that defines it; relative paths are relative to the
+/// directory containing the file. Empty lines and lines starting with '#' are
+/// ignored.
+void CodeGenVTables::loadVTableOwners() {
+  LoadedVTableOwners = true;
+
+  StringRef FileName = CGM.getCodeGenOpts().VTableOwnersFile;
+  if (FileName.empty())
+    return;
+
+  DiagnosticsEngine &Diags = CGM.getDiags();
+  auto BufferOrErr = llvm::MemoryBuffer::getFile(FileName);
+  if (std::error_code EC = BufferOrErr.getError()) {
+    Diags.Report(diag::err_fe_unable_to_read_vtable_owners)
+        << FileName << EC.message();
+    return;
+  }
+
+  StringRef Directory = llvm::sys::path::parent_path(FileName);
+  llvm::StringMap<unsigned> OwnerFileIndices;
+  SmallVector<StringRef, 0> Lines;
+  (*BufferOrErr)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                                    /*KeepEmpty=*/false);
+  for (unsigned I = 0, N = Lines.size(); I != N; ++I) {
+    StringRef Line = Lines[I].trim();
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+
+    size_t Separator = Line.find_first_of(" \t");
+    if (Separator == StringRef::npos) {
+      Diags.Report(diag::err_fe_malformed_vtable_owners)
+          << (I + 1) << FileName;
+      VTableOwners.clear();
+      return;
+    }
+    StringRef Symbol = Line.substr(0, Separator);
+    StringRef Owner = Line.substr(Separator).trim();
+
+    SmallString<256> Path(Owner);
+    if (llvm::sys::path::is_relative(Path) && !Directory.empty()) {
+      Path = Directory;
+      llvm::sys::path::append(Path, Owner);
+    }
+
+    auto Index = OwnerFileIndices.insert(
+        std::make_pair(Path.str(), unsigned(VTableOwnerFiles.size())));
+    if (Index.second)
+      VTableOwnerFiles.push_back(std::make_pair(Path.str().str(), None));
+    VTableOwners[Symbol] = Index.first->second;
+  }
+}
+
+CodeGenVTables::VTableOwnership
+CodeGenVTables::getVTableOwnership(const CXXRecordDecl *RD) {
+  if (!LoadedVTableOwners)
+    loadVTableOwners();
+  if (VTableOwners.empty())
+    return VTableOwnerUnknown;
+
+  // Only vtables that every user would otherwise emit are assigned to a
+  // single translation unit.
+  if (CGM.getTarget().getCXXABI().isMicrosoft() ||
+      CGM.getLangOpts().AppleKext || !RD->isExternallyVisible() ||
+      RD->hasAttr<DLLImportAttr>() || RD->hasAttr<DLLExportAttr>())
+    return VTableOwnerUnknown;
+
+  // Mangle the vtable's name only the first time the class is asked about.
+  auto Cached = VTableOwnerIndices.insert(std::make_pair(RD, None));
+  if (Cached.second) {
+    SmallString<256> Name;
+    llvm::raw_svector_ostream Out(Name);
+    cast<ItaniumMangleContext>(CGM.getCXXABI().getMangleContext())
+        .mangleCXXVTable(RD, Out);
+    auto Pos = VTableOwners.find(Name);
+    if (Pos != VTableOwners.end())
+      Cached.first->second = Pos->second;
+  }
+  if (!Cached.first->second)
+    return VTableOwnerUnknown;
+
+  auto &Owner = VTableOwnerFiles[*Cached.first->second];
+  if (!Owner.second) {
+    // Compare file identities rather than paths, which may be spelled
+    // differently on the command line and in the file.
+    const SourceManager &SM = CGM.getContext().getSourceManager();
+    const FileEntry *MainFile = SM.getFileEntryForID(SM.getMainFileID());
+    llvm::sys::fs::UniqueID OwnerID;
+    Owner.second = MainFile &&
+                   !llvm::sys::fs::getUniqueID(Owner.first, OwnerID) &&
+                   OwnerID == MainFile->getUniqueID();
+  }
+  return *Owner.second ? VTableOwnedHere : VTableOwnedElsewhere;
+}
+
 /// Given that we're currently at the end of the translation unit, and
 /// we've emitted a reference to the vtable for this class, should
 /// we define that vtable?
@@ -935,17 +1059,11 @@ void CodeGenModule::EmitVTableTypeMetadata(llvm::GlobalVariable *VTable,
     if (&E1 == &E2)
       return false;
 
-    std::string S1;
-    llvm::raw_string_ostream O1(S1);
-    getCXXABI().getMangleContext().mangleTypeName(
-        QualType(E1.first->getTypeForDecl(), 0), O1);
-    O1.flush();
-
-    std::string S2;
-    llvm::raw_string_ostream O2(S2);
-    getCXXABI().getMangleContext().mangleTypeName(
-        QualType(E2.first->getTypeForDecl(), 0), O2);
-    O2.flush();
+    SmallString<256> B1, B2;
+    StringRef S1 = getCXXABI().getMangleContext().getMangledTypeName(
+        QualType(E1.first->getTypeForDecl(), 0), B1);
+    StringRef S2 = getCXXABI().getMangleContext().getMangledTypeName(
+        QualType(E2.first->getTypeForDecl(), 0), B2);
 
     if (S1 < S2)
       return true;
@@ -20,6 +20,8 @@
 #include "clang/AST/VTableBuilder.h"
 #include "clang/Basic/ABI.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/GlobalVariable.h"
 
 namespace clang {
@@ -55,6 +57,24 @@ class CodeGenVTables {
   /// Cache for the deleted virtual member call function.
   llvm::Constant *DeletedVirtualFn = nullptr;
 
+  /// Whether the -fvtable-owners file has been read.
+  bool LoadedVTableOwners = false;
+
+  /// The index into VTableOwnerFiles of the file that defines each vtable
+  /// listed in the -fvtable-owners file, by the mangled name of the vtable.
+  llvm::StringMap<unsigned> VTableOwners;
+
+  /// The files named in the -fvtable-owners file, and whether each one is the
+  /// main file of this translation unit, once that has been determined.
+  std::vector<std::pair<std::string, llvm::Optional<bool>>> VTableOwnerFiles;
+
+  /// The index into VTableOwnerFiles for each class whose vtable ownership
+  /// has been looked up, or None if its vtable is not listed.
+  llvm::DenseMap<const CXXRecordDecl *, llvm::Optional<unsigned>>
+      VTableOwnerIndices;
+
+  void loadVTableOwners();
+
   /// emitThunk - Emit a single thunk.
   void emitThunk(GlobalDecl GD, const ThunkInfo &Thunk, bool ForVTable);
 
@@ -119,6 +139,22 @@ public:
   void GenerateClassData(const CXXRecordDecl *RD);
 
   bool isVTableExternal(const CXXRecordDecl *RD);
+
+  enum VTableOwnership {
+    /// The vtable is emitted wherever it is used.
+    VTableOwnerUnknown,
+    /// The vtable must be defined, non-discardably, in this translation unit.
+    VTableOwnedHere,
+    /// The vtable is defined in another translation unit.
+    VTableOwnedElsewhere
+  };
+
+  /// getVTableOwnership - Determine which translation unit the -fvtable-owners
+  /// file assigns the vtable (and the VTT and type_info object) of the given
+  /// class to. Only classes whose vtable would otherwise be a discardable
+  /// definition, emitted by every translation unit that uses it, are
+  /// assigned.
+  VTableOwnership getVTableOwnership(const CXXRecordDecl *RD);
 };
 
 } // end namespace CodeGen
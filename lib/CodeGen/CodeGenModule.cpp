@@ -43,6 +43,7 @@
 #include "clang/Basic/Version.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "clang/Sema/SemaDiagnostic.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/CallingConv.h"
@@ -58,6 +59,13 @@
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegen"
+
+STATISTIC(NumUnmangledDeferredDecls,
+          "The # of deferred functions whose names were not mangled up front");
+STATISTIC(NumUnmangledDeferredDeclsReferenced,
+          "The # of those functions that had to be mangled later");
+
 static const char AnnotationSection[] = "llvm.metadata";
 
 static CGCXXABI *createCXXABI(CodeGenModule &CGM) {
@@ -141,8 +149,8 @@ CodeGenModule::CodeGenModule(ASTContext &C, const HeaderSearchOptions &HSO,
     ObjCData.reset(new ObjCEntrypoints());
 
   if (CodeGenOpts.hasProfileClangUse()) {
-    auto ReaderOrErr = llvm::IndexedInstrProfReader::create(
-        CodeGenOpts.ProfileInstrumentUsePath);
+    auto ReaderOrErr =
+        acquireIndexedProfileReader(CodeGenOpts.ProfileInstrumentUsePath);
     if (auto E = ReaderOrErr.takeError()) {
       unsigned DiagID = Diags.getCustomDiagID(DiagnosticsEngine::Error,
                                               "Could not read profile %0: %1");
@@ -160,7 +168,11 @@ CodeGenModule::CodeGenModule(ASTContext &C, const HeaderSearchOptions &HSO,
     CoverageMapping.reset(new CoverageMappingModuleGen(*this, *CoverageInfo));
 }
 
-CodeGenModule::~CodeGenModule() {}
+CodeGenModule::~CodeGenModule() {
+  if (PGOReader)
+    releaseIndexedProfileReader(CodeGenOpts.ProfileInstrumentUsePath,
+                                std::move(PGOReader));
+}
 
 void CodeGenModule::createObjCRuntime() {
   // This is just isGNUFamily(), but we want to force implementors of
@@ -1513,6 +1525,7 @@ ConstantAddress CodeGenModule::GetWeakRefReference(const ValueDecl *VD) {
     return ConstantAddress(Ptr, Alignment);
   }
 
+  noteReferenceWithoutDecl(AA->getAliasee());
   llvm::Constant *Aliasee;
   if (isa<llvm::FunctionType>(DeclTy))
     Aliasee = GetOrCreateLLVMFunction(AA->getAliasee(), DeclTy,
@@ -1638,6 +1651,14 @@ void CodeGenModule::EmitGlobal(GlobalDecl GD) {
     CXXGlobalInits.push_back(nullptr);
   }
 
+  // A function that has not been referenced yet need not be mangled until it
+  // is, which for most inline functions in headers is never.
+  if (!MustBeEmitted(Global) && mayDeferMangling(GD)) {
+    ++NumUnmangledDeferredDecls;
+    UnmangledDeferredDecls[GD.getCanonicalDecl()] = GD;
+    return;
+  }
+
   StringRef MangledName = getMangledName(GD);
   if (llvm::GlobalValue *GV = GetGlobalValue(MangledName)) {
     // The value has already been used and should therefore be emitted.
@@ -1654,6 +1675,64 @@ void CodeGenModule::EmitGlobal(GlobalDecl GD) {
   }
 }
 
+/// Whether the mangling of the given deferred definition can be put off until
+/// the function is referenced through its declaration.
+bool CodeGenModule::mayDeferMangling(GlobalDecl GD) {
+  if (!CodeGenOpts.DeferInlineMangling ||
+      !getTarget().getCXXABI().isItaniumFamily())
+    return false;
+
+  // Only functions with ordinary C++ mangled names (which start with "_Z")
+  // can be found again by their declaration.
+  const auto *FD = dyn_cast<FunctionDecl>(GD.getDecl());
+  if (!FD || FD->hasAttr<AsmLabelAttr>() ||
+      !getCXXABI().getMangleContext().shouldMangleDeclName(FD))
+    return false;
+
+  // If the function has been mangled already, it may have been referenced.
+  if (MangledDeclNames.count(GD.getCanonicalDecl()))
+    return false;
+
+  // If its name may have been referenced without a declaration, we need to
+  // check. The name of the function itself appears in its mangled name.
+  if (!NamesReferencedWithoutDecl.empty()) {
+    const IdentifierInfo *II = FD->getIdentifier();
+    if (!II)
+      return false;
+    for (const auto &Name : NamesReferencedWithoutDecl)
+      if (Name.getKey().find(II->getName()) != StringRef::npos)
+        return false;
+  }
+
+  return true;
+}
+
+/// If the definition of the function referenced through the given
+/// declaration is deferred without a mangled name, compute its name and
+/// record it as an ordinary deferred decl.
+void CodeGenModule::mangleDeferredDecl(GlobalDecl GD) {
+  auto It = UnmangledDeferredDecls.find(GD.getCanonicalDecl());
+  if (It == UnmangledDeferredDecls.end())
+    return;
+  GlobalDecl Definition = It->second;
+  UnmangledDeferredDecls.erase(It);
+  ++NumUnmangledDeferredDeclsReferenced;
+  DeferredDecls[getMangledName(Definition)] = Definition;
+}
+
+/// Note that a mangled name is being referenced other than through the
+/// declaration of the entity it names. Any deferred function could be the
+/// one with that name, so all of them are mangled.
+void CodeGenModule::noteReferenceWithoutDecl(StringRef MangledName) {
+  if (!CodeGenOpts.DeferInlineMangling || !MangledName.startswith("_Z"))
+    return;
+  NamesReferencedWithoutDecl.insert(MangledName);
+  for (const auto &Entry : UnmangledDeferredDecls)
+    DeferredDecls[getMangledName(Entry.second)] = Entry.second;
+  NumUnmangledDeferredDeclsReferenced += UnmangledDeferredDecls.size();
+  UnmangledDeferredDecls.clear();
+}
+
 namespace {
   struct FunctionIsDirectlyRecursive :
     public RecursiveASTVisitor<FunctionIsDirectlyRecursive> {
@@ -1863,6 +1942,13 @@ CodeGenModule::GetOrCreateLLVMFunction(StringRef MangledName,
                                        bool IsForDefinition) {
   const Decl *D = GD.getDecl();
 
+  // Make sure that a deferred definition of the function can be found by
+  // its mangled name below.
+  if (!D)
+    noteReferenceWithoutDecl(MangledName);
+  else if (!UnmangledDeferredDecls.empty())
+    mangleDeferredDecl(GD);
+
   // Lookup the entry, lazily creating it if necessary.
   llvm::GlobalValue *Entry = GetGlobalValue(MangledName);
   if (Entry) {
@@ -3003,6 +3089,7 @@ void CodeGenModule::EmitAliasDefinition(GlobalDecl GD) {
 
   // Create a reference to the named value.  This ensures that it is emitted
   // if a deferred decl.
+  noteReferenceWithoutDecl(AA->getAliasee());
   llvm::Constant *Aliasee;
   if (isa<llvm::FunctionType>(DeclTy))
     Aliasee = GetOrCreateLLVMFunction(AA->getAliasee(), DeclTy, GD,
@@ -3083,6 +3170,7 @@ void CodeGenModule::emitIFuncDefinition(GlobalDecl GD) {
   Aliases.push_back(GD);
 
   llvm::Type *DeclTy = getTypes().ConvertTypeForMem(D->getType());
+  noteReferenceWithoutDecl(IFA->getResolver());
   llvm::Constant *Resolver =
       GetOrCreateLLVMFunction(IFA->getResolver(), DeclTy, GD,
                               /*ForVTable=*/false);
@@ -4314,11 +4402,10 @@ llvm::Metadata *CodeGenModule::CreateMetadataIdentifierForType(QualType T) {
     return InternalId;
 
   if (isExternallyVisible(T->getLinkage())) {
-    std::string OutName;
-    llvm::raw_string_ostream Out(OutName);
-    getCXXABI().getMangleContext().mangleTypeName(T, Out);
-
-    InternalId = llvm::MDString::get(getLLVMContext(), Out.str());
+    SmallString<256> Buffer;
+    InternalId = llvm::MDString::get(
+        getLLVMContext(),
+        getCXXABI().getMangleContext().getMangledTypeName(T, Buffer));
   } else {
     InternalId = llvm::MDNode::getDistinct(getLLVMContext(),
                                            llvm::ArrayRef<llvm::Metadata *>());
@@ -32,6 +32,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/Transforms/Utils/SanitizerStats.h"
@@ -307,6 +308,21 @@ private:
   /// yet.
   std::map<StringRef, GlobalDecl> DeferredDecls;
 
+  /// With -fdefer-inline-mangling, the deferred functions that have not been
+  /// referenced and whose names have not been mangled yet, keyed by their
+  /// canonical GlobalDecl. A function moves into DeferredDecls when it is
+  /// first referenced, or when a name that might be its own is referenced
+  /// without a declaration.
+  llvm::DenseMap<GlobalDecl, GlobalDecl> UnmangledDeferredDecls;
+
+  /// The mangled names that have been referenced without a declaration, for
+  /// instance by a runtime function or an alias.
+  llvm::StringSet<> NamesReferencedWithoutDecl;
+
+  bool mayDeferMangling(GlobalDecl GD);
+  void mangleDeferredDecl(GlobalDecl GD);
+  void noteReferenceWithoutDecl(StringRef MangledName);
+
   /// This is a list of deferred decls which we have seen that *are* actually
   /// referenced. These get code generated when the module is done.
   struct DeferredGlobal {
@@ -16,11 +16,17 @@
 #include "CoverageMappingGen.h"
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/AST/StmtVisitor.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TimeValue.h"
+#include <algorithm>
+#include <mutex>
 
 static llvm::cl::opt<bool> EnableValueProfiling(
   "enable-value-profiling", llvm::cl::ZeroOrMore,
@@ -29,6 +35,13 @@ static llvm::cl::opt<bool> EnableValueProfiling(
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegen"
+
+STATISTIC(NumProfileReadersCreated,
+          "The # of indexed profile readers opened");
+STATISTIC(NumProfileReadersReused,
+          "The # of indexed profile readers reused from an earlier compile");
+
 void CodeGenPGO::setFuncName(StringRef Name,
                              llvm::GlobalValue::LinkageTypes Linkage) {
   llvm::IndexedInstrProfReader *PGOReader = CGM.getPGOReader();
@@ -892,3 +905,122 @@ llvm::MDNode *CodeGenFunction::createProfileWeightsForLoop(const Stmt *Cond,
   return createProfileWeights(LoopCount,
                               std::max(*CondCount, LoopCount) - LoopCount);
 }
+
+namespace {
+/// The identity and state of a profile file when a reader for it was opened.
+struct ProfileFileKey {
+  llvm::sys::fs::UniqueID ID;
+  uint64_t Size;
+  uint64_t ModTime;
+
+  bool operator==(const ProfileFileKey &Other) const {
+    return ID == Other.ID && Size == Other.Size && ModTime == Other.ModTime;
+  }
+};
+
+/// A reader that is not in use, with the state of its file.
+struct IdleProfileReader {
+  std::string Path;
+  ProfileFileKey Key;
+  std::unique_ptr<llvm::IndexedInstrProfReader> Reader;
+};
+
+struct ProfileReaderCache {
+  /// The number of idle readers to keep. Each of them keeps its profile
+  /// mapped, so only the most recently released ones are kept.
+  enum { MaxIdleReaders = 4 };
+
+  std::mutex Lock;
+
+  /// The readers that are not in use, least recently released first.
+  std::vector<IdleProfileReader> Idle;
+
+  /// The state of the files of the readers that are in use and may be
+  /// reused once they are released.
+  llvm::DenseMap<const llvm::IndexedInstrProfReader *, ProfileFileKey> InUse;
+};
+} // end anonymous namespace
+
+static llvm::ManagedStatic<ProfileReaderCache> ProfileReaders;
+
+/// Get the state of the profile file at \p Path, if a reader opened now could
+/// safely be reused while the file stays in that state.
+static bool getProfileFileKey(StringRef Path, ProfileFileKey &Key) {
+  // Modification times only have a resolution of one second. A file modified
+  // in the current second might be modified again without its time changing,
+  // so only files that were last modified before then are considered
+  // unchanged when their state is the same.
+  uint64_t Now = llvm::sys::TimeValue::now().toEpochTime();
+  llvm::sys::fs::file_status Status;
+  if (llvm::sys::fs::status(Path, Status))
+    return false;
+  Key.ID = Status.getUniqueID();
+  Key.Size = Status.getSize();
+  Key.ModTime = Status.getLastModificationTime().toEpochTime();
+  return Key.ModTime < Now;
+}
+
+llvm::Expected<std::unique_ptr<llvm::IndexedInstrProfReader>>
+CodeGen::acquireIndexedProfileReader(StringRef Path) {
+  ProfileFileKey Key;
+  bool HaveKey = getProfileFileKey(Path, Key);
+  {
+    std::lock_guard<std::mutex> Guard(ProfileReaders->Lock);
+    std::vector<IdleProfileReader> &Idle = ProfileReaders->Idle;
+    auto Pos = std::find_if(Idle.begin(), Idle.end(),
+                            [&](const IdleProfileReader &R) {
+                              return R.Path == Path;
+                            });
+    if (Pos != Idle.end()) {
+      // A reader for a file that has changed is of no more use.
+      std::unique_ptr<llvm::IndexedInstrProfReader> Reader;
+      if (HaveKey && Pos->Key == Key)
+        Reader = std::move(Pos->Reader);
+      Idle.erase(Pos);
+      if (Reader) {
+        ++NumProfileReadersReused;
+        ProfileReaders->InUse[Reader.get()] = Key;
+        return std::move(Reader);
+      }
+    }
+  }
+
+  // Indexed profiles can be very large, and only the records of the functions
+  // that are emitted are ever looked up. Don't require a null terminator, so
+  // that the file is always mapped rather than read into memory.
+  auto BufferOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
+      Path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (std::error_code EC = BufferOrErr.getError())
+    return llvm::errorCodeToError(EC);
+  auto ReaderOrErr =
+      llvm::IndexedInstrProfReader::create(std::move(BufferOrErr.get()));
+  if (ReaderOrErr)
+    ++NumProfileReadersCreated;
+  if (ReaderOrErr && HaveKey) {
+    std::lock_guard<std::mutex> Guard(ProfileReaders->Lock);
+    ProfileReaders->InUse[ReaderOrErr->get()] = Key;
+  }
+  return ReaderOrErr;
+}
+
+void CodeGen::releaseIndexedProfileReader(
+    StringRef Path, std::unique_ptr<llvm::IndexedInstrProfReader> Reader) {
+  std::lock_guard<std::mutex> Guard(ProfileReaders->Lock);
+  auto Pos = ProfileReaders->InUse.find(Reader.get());
+  if (Pos == ProfileReaders->InUse.end())
+    return;
+  ProfileFileKey Key = Pos->second;
+  ProfileReaders->InUse.erase(Pos);
+
+  // Keep only the most recently released reader for each file, and only the
+  // most recently released ones overall.
+  std::vector<IdleProfileReader> &Idle = ProfileReaders->Idle;
+  Idle.erase(std::remove_if(Idle.begin(), Idle.end(),
+                            [&](const IdleProfileReader &R) {
+                              return R.Path == Path;
+                            }),
+             Idle.end());
+  if (Idle.size() == ProfileReaderCache::MaxIdleReaders)
+    Idle.erase(Idle.begin());
+  Idle.push_back({Path.str(), Key, std::move(Reader)});
+}
@@ -117,6 +117,24 @@ public:
   }
 };
 
+/// Open the indexed profile at \p Path for -fprofile-instr-use. If a reader
+/// for the same, unchanged file was released earlier in this process, that
+/// reader (and the profile summary it has already read) is reused.
+llvm::Expected<std::unique_ptr<llvm::IndexedInstrProfReader>>
+acquireIndexedProfileReader(StringRef Path);
+
+/// Make a reader returned by acquireIndexedProfileReader available to later
+/// code generators in this process.
+///
+/// Up to four released readers are kept, each with its profile file still
+/// mapped. They are only destroyed when a later reader displaces them, when
+/// their file changes and it is opened again, or at llvm_shutdown(). A
+/// long-running process that uses the CodeGen library, such as a libclang
+/// client, therefore keeps the most recently used profiles mapped after the
+/// compilations that used them have finished.
+void releaseIndexedProfileReader(
+    StringRef Path, std::unique_ptr<llvm::IndexedInstrProfReader> Reader);
+
 }  // end namespace CodeGen
 }  // end namespace clang
 
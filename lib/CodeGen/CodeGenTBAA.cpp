@@ -156,10 +156,10 @@ CodeGenTBAA::getTBAAInfo(QualType QTy) {
     if (!Features.CPlusPlus || !ETy->getDecl()->isExternallyVisible())
       return MetadataCache[Ty] = getChar();
 
-    SmallString<256> OutName;
-    llvm::raw_svector_ostream Out(OutName);
-    MContext.mangleTypeName(QualType(ETy, 0), Out);
-    return MetadataCache[Ty] = createTBAAScalarType(OutName, getChar());
+    SmallString<256> Buffer;
+    return MetadataCache[Ty] = createTBAAScalarType(
+               MContext.getMangledTypeName(QualType(ETy, 0), Buffer),
+               getChar());
   }
 
   // For now, handle any other kind of type conservatively.
@@ -269,11 +269,11 @@ CodeGenTBAA::getTBAAStructTypeInfo(QualType QTy) {
           FieldNode, Layout.getFieldOffset(idx) / Context.getCharWidth()));
     }
 
-    SmallString<256> OutName;
+    SmallString<256> Buffer;
+    StringRef OutName;
     if (Features.CPlusPlus) {
       // Don't use the mangler for C code.
-      llvm::raw_svector_ostream Out(OutName);
-      MContext.mangleTypeName(QualType(Ty, 0), Out);
+      OutName = MContext.getMangledTypeName(QualType(Ty, 0), Buffer);
     } else {
       OutName = RD->getName();
     }
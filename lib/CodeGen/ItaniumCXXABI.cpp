@@ -2480,9 +2480,9 @@ public:
 
 llvm::GlobalVariable *ItaniumRTTIBuilder::GetAddrOfTypeName(
     QualType Ty, llvm::GlobalVariable::LinkageTypes Linkage) {
-  SmallString<256> Name;
-  llvm::raw_svector_ostream Out(Name);
-  CGM.getCXXABI().getMangleContext().mangleCXXRTTIName(Ty, Out);
+  SmallString<256> Buffer;
+  StringRef Name =
+      CGM.getCXXABI().getMangleContext().getMangledCXXRTTIName(Ty, Buffer);
 
   // We know that the mangled name of the type starts at index 4 of the
   // mangled name of the typename, so we can just index into it in order to
@@ -3377,6 +3377,29 @@ static void SplitDebugInfo(const ToolChain &TC, Compilation &C, const Tool &T,
   C.addCommand(llvm::make_unique<Command>(JA, T, Exec, StripArgs, II));
 }
 
+/// \brief Link the objects that cc1 wrote for the partitions from
+/// -fparallel-codegen= into the single object the compile job should produce.
+static void MergeParallelCodeGenPartitions(const ToolChain &TC, Compilation &C,
+                                           const Tool &T, const JobAction &JA,
+                                           const ArgList &Args,
+                                           const InputInfo &Output,
+                                           const ArgStringList &Partitions) {
+  ArgStringList LinkArgs;
+  LinkArgs.push_back("-r");
+  LinkArgs.push_back("-o");
+  LinkArgs.push_back(Output.getFilename());
+  InputInfoList PartitionInputs;
+  for (const char *Partition : Partitions) {
+    LinkArgs.push_back(Partition);
+    PartitionInputs.push_back(
+        InputInfo(types::TY_Object, Partition, Output.getBaseInput()));
+  }
+
+  const char *Exec = Args.MakeArgString(TC.GetLinkerPath());
+  C.addCommand(
+      llvm::make_unique<Command>(JA, T, Exec, LinkArgs, PartitionInputs));
+}
+
 /// \brief Vectorize at all optimization levels greater than 1 except for -Oz.
 /// For -Oz the loop vectorizer is disable, while the slp vectorizer is enabled.
 static bool shouldEnableVectorizerAtOLevel(const ArgList &Args, bool isSlpVec) {
@@ -4773,6 +4796,43 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
                     options::OPT_fno_unique_section_names, true))
     CmdArgs.push_back("-fno-unique-section-names");
 
+  // cc1 writes the objects for the partitions after the first next to its
+  // output file, so it is given a temporary output, and a relocatable link
+  // merges the partitions into the requested object afterwards. Assembly and
+  // bitcode are not partitioned.
+  ArgStringList PartitionObjects;
+  if (Arg *A = Args.getLastArg(options::OPT_fparallel_codegen_EQ)) {
+    unsigned Partitions;
+    if (StringRef(A->getValue()).getAsInteger(10, Partitions)) {
+      D.Diag(diag::err_drv_invalid_int_value) << A->getAsString(Args)
+                                              << A->getValue();
+    } else if (Partitions > 1 && Output.isFilename() &&
+               Output.getType() == types::TY_Object &&
+               StringRef(Output.getFilename()) != "-") {
+      if (getToolChain().getTriple().isKnownWindowsMSVCEnvironment()) {
+        D.Diag(diag::err_drv_unsupported_opt_for_target)
+            << A->getAsString(Args) << getToolChain().getTripleString();
+      } else {
+        A->render(Args, CmdArgs);
+        std::string FirstPartition = D.GetTemporaryPath(
+            llvm::sys::path::stem(Output.getFilename()),
+            types::getTypeTempSuffix(types::TY_Object));
+        PartitionObjects.push_back(
+            C.addTempFile(Args.MakeArgString(FirstPartition)));
+        // These are the names that cc1 gives the other partitions.
+        StringRef Extension = llvm::sys::path::extension(FirstPartition);
+        for (unsigned I = 1; I < Partitions; ++I) {
+          SmallString<128> Path(FirstPartition);
+          llvm::sys::path::replace_extension(Path, Twine(I) + Extension);
+          PartitionObjects.push_back(
+              C.addTempFile(Args.MakeArgString(Path)));
+        }
+      }
+    }
+  }
+  Args.AddLastArg(CmdArgs, options::OPT_fminimal_codegen_pipeline);
+  Args.AddLastArg(CmdArgs, options::OPT_fvtable_owners_EQ);
+
   Args.AddAllArgs(CmdArgs, options::OPT_finstrument_functions);
 
   if (Args.hasFlag(options::OPT_fxray_instrument,
@@ -5033,6 +5093,8 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     CmdArgs.push_back(A->getValue());
   }
 
+  Args.AddLastArg(CmdArgs, options::OPT_fconstexpr_bytecode);
+
   if (Arg *A = Args.getLastArg(options::OPT_fbracket_depth_EQ)) {
     CmdArgs.push_back("-fbracket-depth");
     CmdArgs.push_back(A->getValue());
@@ -6179,6 +6241,9 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
 
   if (Output.getType() == types::TY_Dependencies) {
     // Handled with other dependency code.
+  } else if (!PartitionObjects.empty()) {
+    CmdArgs.push_back("-o");
+    CmdArgs.push_back(PartitionObjects.front());
   } else if (Output.isFilename()) {
     CmdArgs.push_back("-o");
     CmdArgs.push_back(Output.getFilename());
@@ -6265,6 +6330,10 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
   }
 
+  if (!PartitionObjects.empty())
+    MergeParallelCodeGenPartitions(getToolChain(), C, *this, JA, Args, Output,
+                                   PartitionObjects);
+
   // Handle the debug info splitting at object creation time if we're
   // creating an object.
   // TODO: Currently only works on linux with newer objcopy.
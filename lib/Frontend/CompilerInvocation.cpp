@@ -501,6 +501,7 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
   Opts.SplitDwarfFile = Args.getLastArgValue(OPT_split_dwarf_file);
   Opts.SplitDwarfInlining = !Args.hasArg(OPT_fno_split_dwarf_inlining);
   Opts.DebugTypeExtRefs = Args.hasArg(OPT_dwarf_ext_refs);
+  Opts.DebugCtorHoming = Args.hasArg(OPT_fuse_ctor_homing);
   Opts.DebugExplicitImport = Triple.isPS4CPU();
 
   for (const auto &Arg : Args.getAllArgValues(OPT_fdebug_prefix_map_EQ))
@@ -513,6 +514,7 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
   Opts.DisableLLVMOpts = Args.hasArg(OPT_disable_llvm_optzns);
   Opts.DisableLLVMPasses = Args.hasArg(OPT_disable_llvm_passes);
   Opts.DisableRedZone = Args.hasArg(OPT_disable_red_zone);
+  Opts.MinimalCodeGenPipeline = Args.hasArg(OPT_fminimal_codegen_pipeline);
   Opts.ForbidGuardVariables = Args.hasArg(OPT_fforbid_guard_variables);
   Opts.UseRegisterSizedBitfieldAccess = Args.hasArg(
     OPT_fuse_register_sized_bitfield_access);
@@ -535,6 +537,7 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
   Opts.DisableIntegratedAS = Args.hasArg(OPT_fno_integrated_as);
   Opts.Autolink = !Args.hasArg(OPT_fno_autolink);
   Opts.SampleProfileFile = Args.getLastArgValue(OPT_fprofile_sample_use_EQ);
+  Opts.VTableOwnersFile = Args.getLastArgValue(OPT_fvtable_owners_EQ);
 
   setPGOInstrumentor(Opts, Args, Diags);
   Opts.InstrProfileOutput =
@@ -614,8 +617,29 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
 
   Opts.MergeFunctions = Args.hasArg(OPT_fmerge_functions);
 
+  Opts.DeferInlineMangling = Args.hasArg(OPT_fdefer_inline_mangling);
+
   Opts.NoUseJumpTables = Args.hasArg(OPT_fno_jump_tables);
 
+  if (Arg *A = Args.getLastArg(OPT_fparallel_codegen_EQ)) {
+    unsigned Partitions =
+        getLastArgIntValue(Args, OPT_fparallel_codegen_EQ, 1, Diags);
+    StringRef OutputFile = Args.getLastArgValue(OPT_o);
+    if (Partitions > 1 && (OutputFile.empty() || OutputFile == "-")) {
+      Diags.Report(diag::err_drv_argument_only_allowed_with)
+          << A->getAsString(Args) << "-o <file>";
+    } else {
+      // Partition I after the first is named like the output, with I
+      // inserted before its extension.
+      StringRef Extension = llvm::sys::path::extension(OutputFile);
+      for (unsigned I = 1; I < Partitions; ++I) {
+        SmallString<128> Path(OutputFile);
+        llvm::sys::path::replace_extension(Path, Twine(I) + Extension);
+        Opts.ParallelCodeGenOutputs.push_back(Path.str());
+      }
+    }
+  }
+
   Opts.PrepareForLTO = Args.hasArg(OPT_flto, OPT_flto_EQ);
   const Arg *A = Args.getLastArg(OPT_flto, OPT_flto_EQ);
   Opts.EmitSummaryIndex = A && A->containsValue("thin");
@@ -1220,6 +1244,11 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.ShowHelp = Args.hasArg(OPT_help);
   Opts.ShowStats = Args.hasArg(OPT_print_stats);
   Opts.ShowTimers = Args.hasArg(OPT_ftime_report);
+  Opts.TemplateProfileOutput =
+      Args.getLastArgValue(OPT_ftemplate_profile_output_EQ);
+  Opts.TemplateProfile = Args.hasArg(OPT_ftemplate_profile) ||
+                         !Opts.TemplateProfileOutput.empty();
+  Opts.ASTMemoryReport = Args.hasArg(OPT_fast_memory_report);
   Opts.ShowVersion = Args.hasArg(OPT_version);
   Opts.ASTMergeFiles = Args.getAllArgValues(OPT_ast_merge);
   Opts.LLVMArgs = Args.getAllArgValues(OPT_mllvm);
@@ -1237,6 +1266,9 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.ModulesEmbedFiles = Args.getAllArgValues(OPT_fmodules_embed_file_EQ);
   Opts.ModulesEmbedAllFiles = Args.hasArg(OPT_fmodules_embed_all_files);
   Opts.IncludeTimestamps = !Args.hasArg(OPT_fno_pch_timestamp);
+  Opts.IncrementalPCH = Args.hasArg(OPT_fincremental_pch);
+  Opts.CompressASTBlobs = Args.hasArg(OPT_fcompress_ast_blobs);
+  Opts.StoreRecordLayouts = Args.hasArg(OPT_fpch_record_layouts);
 
   Opts.CodeCompleteOpts.IncludeMacros
     = Args.hasArg(OPT_code_completion_macros);
@@ -1929,6 +1961,7 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
     Args.hasArg(OPT_fmodules_search_all);
   Opts.ModulesErrorRecovery = !Args.hasArg(OPT_fno_modules_error_recovery);
   Opts.ImplicitModules = !Args.hasArg(OPT_fno_implicit_modules);
+  Opts.PCHInstantiateTemplates = Args.hasArg(OPT_fpch_instantiate_templates);
   Opts.CharIsSigned = Opts.OpenCL || !Args.hasArg(OPT_fno_signed_char);
   Opts.WChar = Opts.CPlusPlus && !Args.hasArg(OPT_fno_wchar);
   Opts.ShortWChar = Args.hasFlag(OPT_fshort_wchar, OPT_fno_short_wchar, false);
@@ -1963,6 +1996,9 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
       getLastArgIntValue(Args, OPT_fconstexpr_depth, 512, Diags);
   Opts.ConstexprStepLimit =
       getLastArgIntValue(Args, OPT_fconstexpr_steps, 1048576, Diags);
+  Opts.ConstexprBytecode = Args.hasArg(OPT_fconstexpr_bytecode);
+  Opts.ConstexprCallCache = !Args.hasArg(OPT_fno_constexpr_call_cache);
+  Opts.MangledNameCache = !Args.hasArg(OPT_fno_mangled_name_cache);
   Opts.BracketDepth = getLastArgIntValue(Args, OPT_fbracket_depth, 256, Diags);
   Opts.DelayedTemplateParsing = Args.hasArg(OPT_fdelayed_template_parsing);
   Opts.NumLargeByValueCopy =
@@ -104,7 +104,8 @@ struct DepCollectorASTListener : public ASTReaderListener {
                                    /*IsMissing*/false);
   }
   bool visitInputFile(StringRef Filename, bool IsSystem,
-                      bool IsOverridden, bool IsExplicitModule) override {
+                      bool IsOverridden, bool IsExplicitModule,
+                      off_t StoredSize, time_t StoredTime) override {
     if (IsOverridden || IsExplicitModule)
       return true;
 
@@ -223,7 +224,8 @@ public:
   void visitModuleFile(StringRef Filename,
                        serialization::ModuleKind Kind) override;
   bool visitInputFile(StringRef Filename, bool isSystem,
-                      bool isOverridden, bool isExplicitModule) override;
+                      bool isOverridden, bool isExplicitModule,
+                      off_t StoredSize, time_t StoredTime) override;
 };
 }
 
@@ -460,7 +462,9 @@ void DFGImpl::OutputDependencyFile() {
 
 bool DFGASTReaderListener::visitInputFile(llvm::StringRef Filename,
                                           bool IsSystem, bool IsOverridden,
-                                          bool IsExplicitModule) {
+                                          bool IsExplicitModule,
+                                          off_t StoredSize,
+                                          time_t StoredTime) {
   assert(!IsSystem || needsSystemInputFileVisitation());
   if (IsOverridden || IsExplicitModule)
     return true;
@@ -10,6 +10,7 @@
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/ASTMemoryAccounting.h"
 #include "clang/AST/DeclGroup.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -22,6 +23,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -556,6 +558,27 @@ void ASTFrontendAction::ExecuteAction() {
 
   ParseAST(CI.getSema(), CI.getFrontendOpts().ShowStats,
            CI.getFrontendOpts().SkipFunctionBodies);
+
+  if (TemplateInstantiationProfiler *Profiler =
+          CI.getSema().getTemplateProfiler()) {
+    Profiler->printReport(llvm::errs());
+
+    StringRef ProfileFile = CI.getFrontendOpts().TemplateProfileOutput;
+    if (!ProfileFile.empty()) {
+      std::error_code EC;
+      llvm::raw_fd_ostream OS(ProfileFile, EC, llvm::sys::fs::F_Text);
+      if (EC)
+        CI.getDiagnostics().Report(
+            diag::warn_fe_unable_to_open_template_profile)
+            << ProfileFile << EC.message();
+      else
+        Profiler->printFoldedStacks(OS);
+    }
+  }
+
+  if (ASTMemoryAccounting *Accounting =
+          CI.getASTContext().getMemoryAccounting())
+    Accounting->printReport(llvm::errs(), CI.getASTContext());
 }
 
 void PluginASTAction::anchor() { }
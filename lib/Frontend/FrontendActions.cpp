@@ -10,6 +10,7 @@
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/AST/ASTConsumer.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/Version.h"
 #include "clang/Frontend/ASTConsumers.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
@@ -20,6 +21,9 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/ASTWriter.h"
+#include "clang/Serialization/ModuleFileExtension.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -76,8 +80,113 @@ DeclContextPrintAction::CreateASTConsumer(CompilerInstance &CI,
   return CreateDeclContextPrinter();
 }
 
+namespace {
+/// \brief A module file extension that records, in a PCH file built with
+/// -fincremental-pch, a hash of the options that affect the PCH file's
+/// contents but are not otherwise stored in it or checked when it is loaded.
+///
+/// The extension has no contents of its own and no reader: only its metadata
+/// is ever consulted, by \c GeneratePCHAction::isExistingPCHUpToDate.
+class IncrementalPCHOptionsExtension : public ModuleFileExtension {
+  std::string OptionsHash;
+
+  class Writer : public ModuleFileExtensionWriter {
+  public:
+    explicit Writer(ModuleFileExtension *Ext)
+        : ModuleFileExtensionWriter(Ext) {}
+    void writeExtensionContents(Sema &SemaRef,
+                                llvm::BitstreamWriter &Stream) override {}
+  };
+
+public:
+  static const char *const BlockName;
+
+  explicit IncrementalPCHOptionsExtension(std::string OptionsHash)
+      : OptionsHash(std::move(OptionsHash)) {}
+
+  ModuleFileExtensionMetadata getExtensionMetadata() const override {
+    return { BlockName, 1, 0, OptionsHash };
+  }
+
+  std::unique_ptr<ModuleFileExtensionWriter>
+  createExtensionWriter(ASTWriter &Writer) override {
+    return llvm::make_unique<Writer>(this);
+  }
+
+  std::unique_ptr<ModuleFileExtensionReader>
+  createExtensionReader(const ModuleFileExtensionMetadata &Metadata,
+                        ASTReader &Reader, serialization::ModuleFile &Mod,
+                        const llvm::BitstreamCursor &Stream) override {
+    return nullptr;
+  }
+};
+} // end anonymous namespace
+
+const char *const IncrementalPCHOptionsExtension::BlockName =
+    "clang.incremental-pch";
+
+/// \brief Compute a hash of the options that affect the contents of a PCH
+/// file built by \p CI, beyond those that \c ASTReader::isAcceptableASTFile
+/// compares: benign language options, code generation options (which shape
+/// the debug info in object file PCH containers), header search options and
+/// the options controlling the AST writer.
+static std::string getIncrementalPCHOptionsHash(CompilerInstance &CI) {
+  using llvm::hash_combine;
+
+  const LangOptions &LangOpts = CI.getLangOpts();
+  llvm::hash_code Code = llvm::hash_value(getClangFullRepositoryVersion());
+#define LANGOPT(Name, Bits, Default, Description) \
+  Code = hash_combine(Code, static_cast<unsigned>(LangOpts.Name));
+#define ENUM_LANGOPT(Name, Type, Bits, Default, Description) \
+  Code = hash_combine(Code, static_cast<unsigned>(LangOpts.get##Name()));
+#include "clang/Basic/LangOptions.def"
+
+  const CodeGenOptions &CGOpts = CI.getCodeGenOpts();
+#define CODEGENOPT(Name, Bits, Default) \
+  Code = hash_combine(Code, static_cast<unsigned>(CGOpts.Name));
+#define ENUM_CODEGENOPT(Name, Type, Bits, Default) \
+  Code = hash_combine(Code, static_cast<unsigned>(CGOpts.get##Name()));
+#include "clang/Frontend/CodeGenOptions.def"
+  Code = hash_combine(Code, CGOpts.DebugCompilationDir);
+
+  const HeaderSearchOptions &HSOpts = CI.getHeaderSearchOpts();
+  Code = hash_combine(Code, HSOpts.Sysroot, HSOpts.ResourceDir,
+                      HSOpts.ModuleFormat, HSOpts.UseDebugInfo,
+                      HSOpts.UseBuiltinIncludes,
+                      HSOpts.UseStandardSystemIncludes,
+                      HSOpts.UseStandardCXXIncludes, HSOpts.UseLibcxx);
+  for (const HeaderSearchOptions::Entry &E : HSOpts.UserEntries)
+    Code = hash_combine(Code, E.Path, static_cast<unsigned>(E.Group),
+                        static_cast<unsigned>(E.IsFramework),
+                        static_cast<unsigned>(E.IgnoreSysRoot));
+  for (const HeaderSearchOptions::SystemHeaderPrefix &P :
+       HSOpts.SystemHeaderPrefixes)
+    Code = hash_combine(Code, P.Prefix, P.IsSystemHeader);
+
+  const FrontendOptions &FEOpts = CI.getFrontendOpts();
+  Code = hash_combine(Code, static_cast<unsigned>(FEOpts.RelocatablePCH),
+                      static_cast<unsigned>(FEOpts.IncludeTimestamps),
+                      static_cast<unsigned>(FEOpts.CompressASTBlobs),
+                      static_cast<unsigned>(FEOpts.StoreRecordLayouts));
+  for (const auto &Ext : FEOpts.ModuleFileExtensions)
+    Code = Ext->hashExtension(Code);
+
+  return llvm::utohexstr(static_cast<size_t>(Code));
+}
+
 std::unique_ptr<ASTConsumer>
 GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
+  // If we are allowed to, and the existing PCH file is still valid, keep it
+  // rather than regenerating it from scratch.
+  const FrontendOptions &FEOpts = CI.getFrontendOpts();
+  if (FEOpts.IncrementalPCH &&
+      isExistingPCHUpToDate(CI, InFile, FEOpts.OutputFile)) {
+    CI.getDiagnostics().Report(diag::remark_pch_up_to_date)
+        << FEOpts.OutputFile;
+    ReuseExistingPCH = true;
+    return llvm::make_unique<ASTConsumer>();
+  }
+
   std::string Sysroot;
   std::string OutputFile;
   std::unique_ptr<raw_pwrite_stream> OS =
@@ -89,19 +198,141 @@ GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
     Sysroot.clear();
 
   auto Buffer = std::make_shared<PCHBuffer>();
+  // Record the options the PCH file is built with, so that a later
+  // -fincremental-pch build can tell whether they changed.
+  std::vector<llvm::IntrusiveRefCntPtr<ModuleFileExtension>> Extensions =
+      CI.getFrontendOpts().ModuleFileExtensions;
+  if (FEOpts.IncrementalPCH)
+    Extensions.push_back(new IncrementalPCHOptionsExtension(
+        getIncrementalPCHOptionsHash(CI)));
+
   std::vector<std::unique_ptr<ASTConsumer>> Consumers;
   Consumers.push_back(llvm::make_unique<PCHGenerator>(
                         CI.getPreprocessor(), OutputFile, Sysroot,
-                        Buffer, CI.getFrontendOpts().ModuleFileExtensions,
+                        Buffer, Extensions,
                         /*AllowASTWithErrors*/false,
                         /*IncludeTimestamps*/
-                          +CI.getFrontendOpts().IncludeTimestamps));
+                          +CI.getFrontendOpts().IncludeTimestamps,
+                        /*CompressBlobs*/
+                          +CI.getFrontendOpts().CompressASTBlobs,
+                        /*StoreRecordLayouts*/
+                          +CI.getFrontendOpts().StoreRecordLayouts));
   Consumers.push_back(CI.getPCHContainerWriter().CreatePCHContainerGenerator(
       CI, InFile, OutputFile, std::move(OS), Buffer));
 
   return llvm::make_unique<MultiplexConsumer>(std::move(Consumers));
 }
 
+void GeneratePCHAction::ExecuteAction() {
+  if (!ReuseExistingPCH) {
+    ASTFrontendAction::ExecuteAction();
+    return;
+  }
+
+  // Still preprocess the input, so that the dependency file, -H and the other
+  // outputs that observe the preprocessor are produced as by a full build.
+  // Only parsing the input and writing the PCH file are skipped.
+  Preprocessor &PP = getCompilerInstance().getPreprocessor();
+  PP.IgnorePragmas();
+  PP.EnterMainSourceFile();
+  Token Tok;
+  do {
+    PP.Lex(Tok);
+  } while (Tok.isNot(tok::eof));
+}
+
+namespace {
+/// \brief Checks that none of the input files of an existing PCH file have
+/// changed since that PCH file was written, and that it was written with the
+/// same options as the current compilation.
+///
+/// Input files are validated as \c ASTReader::getInputFile does: a file is
+/// out of date if its size or modification time differs from the one
+/// recorded in the PCH file.
+class PCHInputFileChecker : public ASTReaderListener {
+  FileManager &FileMgr;
+  const FileEntry *MainFile;
+  StringRef OptionsHash;
+
+public:
+  bool OutOfDate = false;
+  bool SawMainFile = false;
+  bool SawOptionsHash = false;
+
+  PCHInputFileChecker(FileManager &FileMgr, const FileEntry *MainFile,
+                      StringRef OptionsHash)
+      : FileMgr(FileMgr), MainFile(MainFile), OptionsHash(OptionsHash) {}
+
+  bool needsInputFileVisitation() override { return true; }
+  bool needsSystemInputFileVisitation() override { return true; }
+
+  bool visitInputFile(StringRef Filename, bool isSystem, bool isOverridden,
+                      bool isExplicitModule, off_t StoredSize,
+                      time_t StoredTime) override {
+    // Overridden files have no stable on-disk identity, and without a
+    // recorded modification time (-fno-pch-timestamp) an edit that keeps the
+    // size of a file can't be detected; always rebuild in both cases.
+    const FileEntry *File = nullptr;
+    if (!isOverridden && StoredTime)
+      File = FileMgr.getFile(Filename, /*OpenFile=*/false,
+                             /*CacheFailure=*/false);
+    if (!File || StoredSize != File->getSize() ||
+        StoredTime != File->getModificationTime()) {
+      OutOfDate = true;
+      return false;
+    }
+
+    if (File == MainFile)
+      SawMainFile = true;
+    return true;
+  }
+
+  void readModuleFileExtension(
+      const ModuleFileExtensionMetadata &Metadata) override {
+    if (Metadata.BlockName != IncrementalPCHOptionsExtension::BlockName)
+      return;
+    SawOptionsHash = true;
+    if (Metadata.UserInfo != OptionsHash)
+      OutOfDate = true;
+  }
+};
+} // end anonymous namespace
+
+bool GeneratePCHAction::isExistingPCHUpToDate(CompilerInstance &CI,
+                                              StringRef InFile,
+                                              StringRef OutputFile) {
+  if (OutputFile.empty() || OutputFile == "-" || InFile == "-")
+    return false;
+
+  FileManager &FileMgr = CI.getFileManager();
+  const FileEntry *PCH = FileMgr.getFile(OutputFile, /*OpenFile=*/false,
+                                         /*CacheFailure=*/false);
+  const FileEntry *MainFile = FileMgr.getFile(InFile);
+  if (!PCH || !MainFile)
+    return false;
+
+  // The language, target and preprocessor options must match exactly.
+  if (!ASTReader::isAcceptableASTFile(
+          OutputFile, FileMgr, CI.getPCHContainerReader(), CI.getLangOpts(),
+          CI.getTargetOpts(), CI.getPreprocessorOpts(),
+          CI.getSpecificModuleCachePath()))
+    return false;
+
+  // Every input file must be unchanged, the PCH file must have been built
+  // from the same main file, and the remaining options that affect its
+  // contents must be the same.
+  std::string OptionsHash = getIncrementalPCHOptionsHash(CI);
+  PCHInputFileChecker Checker(FileMgr, MainFile, OptionsHash);
+  if (ASTReader::readASTFileControlBlock(OutputFile, FileMgr,
+                                         CI.getPCHContainerReader(),
+                                         /*FindModuleFileExtensions=*/true,
+                                         Checker,
+                                         /*ValidateDiagnosticOptions=*/false))
+    return false;
+
+  return !Checker.OutOfDate && Checker.SawMainFile && Checker.SawOptionsHash;
+}
+
 std::unique_ptr<raw_pwrite_stream>
 GeneratePCHAction::ComputeASTConsumerArguments(CompilerInstance &CI,
                                                StringRef InFile,
@@ -145,7 +376,11 @@ GenerateModuleAction::CreateASTConsumer(CompilerInstance &CI,
                         Buffer, CI.getFrontendOpts().ModuleFileExtensions,
                         /*AllowASTWithErrors=*/false,
                         /*IncludeTimestamps=*/
-                          +CI.getFrontendOpts().BuildingImplicitModule));
+                          +CI.getFrontendOpts().BuildingImplicitModule,
+                        /*CompressBlobs=*/
+                          +CI.getFrontendOpts().CompressASTBlobs,
+                        /*StoreRecordLayouts=*/
+                          +CI.getFrontendOpts().StoreRecordLayouts));
   Consumers.push_back(CI.getPCHContainerWriter().CreatePCHContainerGenerator(
       CI, InFile, OutputFile, std::move(OS), Buffer));
   return llvm::make_unique<MultiplexConsumer>(std::move(Consumers));
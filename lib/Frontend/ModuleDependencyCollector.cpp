@@ -32,7 +32,8 @@ public:
   bool needsInputFileVisitation() override { return true; }
   bool needsSystemInputFileVisitation() override { return true; }
   bool visitInputFile(StringRef Filename, bool IsSystem, bool IsOverridden,
-                      bool IsExplicitModule) override {
+                      bool IsExplicitModule, off_t StoredSize,
+                      time_t StoredTime) override {
     Collector.addFile(Filename);
     return true;
   }
@@ -37,6 +37,7 @@
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/SemaInternal.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
 using namespace clang;
@@ -342,11 +343,27 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  if (CandidateConversions)
+    llvm::errs() << CandidateConversions->NumHits << "/"
+                 << CandidateConversions->NumHits +
+                        CandidateConversions->NumMisses
+                 << " cacheable candidate conversions found in the cache.\n";
+  if (DeducedSpecializations)
+    llvm::errs() << DeducedSpecializations->NumHits << "/"
+                 << DeducedSpecializations->NumHits +
+                        DeducedSpecializations->NumMisses
+                 << " cacheable template argument deductions found in the "
+                    "cache.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
 }
 
+void Sema::enableTemplateProfiling() {
+  if (!TemplateProfiler)
+    TemplateProfiler.reset(new TemplateInstantiationProfiler(Context));
+}
+
 void Sema::diagnoseNullableToNonnullConversion(QualType DstType,
                                                QualType SrcType,
                                                SourceLocation Loc) {
@@ -644,6 +661,17 @@ void Sema::emitAndClearUnusedLocalTypedefWarnings() {
   UnusedLocalTypedefNameCandidates.clear();
 }
 
+void Sema::PerformAllPendingInstantiations() {
+  if (ExternalSource) {
+    // Load pending instantiations from the external source.
+    SmallVector<PendingImplicitInstantiation, 4> Pending;
+    ExternalSource->ReadPendingInstantiations(Pending);
+    PendingInstantiations.insert(PendingInstantiations.begin(),
+                                 Pending.begin(), Pending.end());
+  }
+  PerformPendingInstantiations();
+}
+
 /// ActOnEndOfTranslationUnit - This is called at the very end of the
 /// translation unit when EOF is reached and all but the top-level scope is
 /// popped.
@@ -675,19 +703,18 @@ void Sema::ActOnEndOfTranslationUnit() {
     // so it will find some names that are not required to be found. This is
     // valid, but we could do better by diagnosing if an instantiation uses a
     // name that was not visible at its first point of instantiation.
-    if (ExternalSource) {
-      // Load pending instantiations from the external source.
-      SmallVector<PendingImplicitInstantiation, 4> Pending;
-      ExternalSource->ReadPendingInstantiations(Pending);
-      PendingInstantiations.insert(PendingInstantiations.begin(),
-                                   Pending.begin(), Pending.end());
-    }
-    PerformPendingInstantiations();
+    PerformAllPendingInstantiations();
 
     if (LateTemplateParserCleanup)
       LateTemplateParserCleanup(OpaqueParser);
 
     CheckDelayedMemberExceptionSpecs();
+  } else if (LangOpts.PCHInstantiateTemplates) {
+    // Instantiate everything the prefix needs now, so that the instantiated
+    // definitions are serialized into the PCH file and every translation unit
+    // that uses it finds them already defined, rather than performing the
+    // same instantiations again.
+    PerformAllPendingInstantiations();
   }
 
   // All delayed member exception specs should be checked or we end up accepting
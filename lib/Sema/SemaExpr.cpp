@@ -4768,7 +4768,10 @@ Sema::ConvertArgumentsForCall(CallExpr *Call, Expr *Fn,
 
       return true;
     }
-    Call->setNumArgs(Context, NumParams);
+
+    // The call was created with room for the default arguments, which
+    // GatherArgumentsForCall adds below.
+    Call->setNumArgsUnsafe(NumParams);
   }
 
   // If too many are passed and not variadic, error on the extras and drop
@@ -4810,7 +4813,7 @@ Sema::ConvertArgumentsForCall(CallExpr *Call, Expr *Fn,
           << FDecl;
       
       // This deletes the extra arguments.
-      Call->setNumArgs(Context, NumParams);
+      Call->shrinkNumArgs(NumParams);
       return true;
     }
   }
@@ -5166,8 +5169,8 @@ static ExprResult ActOnCallExprImpl(Sema &S, Scope *Scope, Expr *Fn,
                                ArgExprs.back()->getLocEnd()));
       }
 
-      return new (S.Context)
-          CallExpr(S.Context, Fn, None, S.Context.VoidTy, VK_RValue, RParenLoc);
+      return CallExpr::Create(S.Context, Fn, None, S.Context.VoidTy, VK_RValue,
+                              RParenLoc);
     }
     if (Fn->getType() == S.Context.PseudoObjectTy) {
       ExprResult result = S.CheckPlaceholderExpr(Fn);
@@ -5185,13 +5188,12 @@ static ExprResult ActOnCallExprImpl(Sema &S, Scope *Scope, Expr *Fn,
 
     if (Dependent) {
       if (ExecConfig) {
-        return new (S.Context) CUDAKernelCallExpr(
+        return CUDAKernelCallExpr::Create(
             S.Context, Fn, cast<CallExpr>(ExecConfig), ArgExprs,
             S.Context.DependentTy, VK_RValue, RParenLoc);
       } else {
-        return new (S.Context)
-            CallExpr(S.Context, Fn, ArgExprs, S.Context.DependentTy, VK_RValue,
-                     RParenLoc);
+        return CallExpr::Create(S.Context, Fn, ArgExprs, S.Context.DependentTy,
+                                VK_RValue, RParenLoc);
       }
     }
 
@@ -5386,34 +5388,6 @@ Sema::BuildResolvedCallExpr(Expr *Fn, NamedDecl *NDecl,
     return ExprError();
   Fn = Result.get();
 
-  // Make the call expr early, before semantic checks.  This guarantees cleanup
-  // of arguments and function on error.
-  CallExpr *TheCall;
-  if (Config)
-    TheCall = new (Context) CUDAKernelCallExpr(Context, Fn,
-                                               cast<CallExpr>(Config), Args,
-                                               Context.BoolTy, VK_RValue,
-                                               RParenLoc);
-  else
-    TheCall = new (Context) CallExpr(Context, Fn, Args, Context.BoolTy,
-                                     VK_RValue, RParenLoc);
-
-  if (!getLangOpts().CPlusPlus) {
-    // C cannot always handle TypoExpr nodes in builtin calls and direct
-    // function calls as their argument checking don't necessarily handle
-    // dependent types properly, so make sure any TypoExprs have been
-    // dealt with.
-    ExprResult Result = CorrectDelayedTyposInExpr(TheCall);
-    if (!Result.isUsable()) return ExprError();
-    TheCall = dyn_cast<CallExpr>(Result.get());
-    if (!TheCall) return Result;
-    Args = llvm::makeArrayRef(TheCall->getArgs(), TheCall->getNumArgs());
-  }
-
-  // Bail out early if calling a builtin with custom typechecking.
-  if (BuiltinID && Context.BuiltinInfo.hasCustomTypechecking(BuiltinID))
-    return CheckBuiltinFunctionCall(FDecl, BuiltinID, TheCall);
-
  retry:
   const FunctionType *FuncT;
   if (const PointerType *PT = Fn->getType()->getAs<PointerType>()) {
@@ -5432,7 +5406,6 @@ Sema::BuildResolvedCallExpr(Expr *Fn, NamedDecl *NDecl,
       ExprResult rewrite = rebuildUnknownAnyFunction(*this, Fn);
       if (rewrite.isInvalid()) return ExprError();
       Fn = rewrite.get();
-      TheCall->setCallee(Fn);
       goto retry;
     }
 
@@ -5440,6 +5413,41 @@ Sema::BuildResolvedCallExpr(Expr *Fn, NamedDecl *NDecl,
       << Fn->getType() << Fn->getSourceRange());
   }
 
+  // Reserve room in the call for the default arguments that
+  // ConvertArgumentsForCall may add. Builtins with custom type checking
+  // never get any.
+  unsigned NumParams = 0;
+  if (const FunctionProtoType *Proto = dyn_cast<FunctionProtoType>(FuncT))
+    if (!BuiltinID || !Context.BuiltinInfo.hasCustomTypechecking(BuiltinID))
+      NumParams = Proto->getNumParams();
+
+  // Make the call expr early, before semantic checks.  This guarantees cleanup
+  // of arguments and function on error.
+  CallExpr *TheCall;
+  if (Config)
+    TheCall = CUDAKernelCallExpr::Create(Context, Fn, cast<CallExpr>(Config),
+                                         Args, Context.BoolTy, VK_RValue,
+                                         RParenLoc, NumParams);
+  else
+    TheCall = CallExpr::Create(Context, Fn, Args, Context.BoolTy, VK_RValue,
+                               RParenLoc, NumParams);
+
+  if (!getLangOpts().CPlusPlus) {
+    // C cannot always handle TypoExpr nodes in builtin calls and direct
+    // function calls as their argument checking don't necessarily handle
+    // dependent types properly, so make sure any TypoExprs have been
+    // dealt with.
+    ExprResult Result = CorrectDelayedTyposInExpr(TheCall);
+    if (!Result.isUsable()) return ExprError();
+    TheCall = dyn_cast<CallExpr>(Result.get());
+    if (!TheCall) return Result;
+    Args = llvm::makeArrayRef(TheCall->getArgs(), TheCall->getNumArgs());
+  }
+
+  // Bail out early if calling a builtin with custom typechecking.
+  if (BuiltinID && Context.BuiltinInfo.hasCustomTypechecking(BuiltinID))
+    return CheckBuiltinFunctionCall(FDecl, BuiltinID, TheCall);
+
   if (getLangOpts().CUDA) {
     if (Config) {
       // CUDA: Kernel calls must be to global functions
@@ -15181,8 +15189,8 @@ ExprResult Sema::CheckPlaceholderExpr(Expr *E) {
       if (FD->getBuiltinID() == Builtin::BI__noop) {
         E = ImpCastExprToType(E, Context.getPointerType(FD->getType()),
                               CK_BuiltinFnToFnPtr).get();
-        return new (Context) CallExpr(Context, E, None, Context.IntTy,
-                                      VK_RValue, SourceLocation());
+        return CallExpr::Create(Context, E, None, Context.IntTy,
+                                VK_RValue, SourceLocation());
       }
     }
 
@@ -6406,8 +6406,8 @@ ExprResult Sema::BuildCXXMemberCallExpr(Expr *E, NamedDecl *FoundDecl,
   ResultType = ResultType.getNonLValueExprType(Context);
 
   CXXMemberCallExpr *CE =
-    new (Context) CXXMemberCallExpr(Context, ME, None, ResultType, VK,
-                                    Exp.get()->getLocEnd());
+    CXXMemberCallExpr::Create(Context, ME, None, ResultType, VK,
+                              Exp.get()->getLocEnd());
   return CE;
 }
 
@@ -9704,8 +9704,8 @@ OMPClause *Sema::ActOnOpenMPReductionClause(
           ELoc, Context.getPointerType(FnTy), VK_RValue, OK_Ordinary,
           DefaultLvalueConversion(DeclareReductionRef.get()).get());
       Expr *Args[] = {LHS.get(), RHS.get()};
-      ReductionOp = new (Context)
-          CallExpr(Context, OVE, Args, Context.VoidTy, VK_RValue, ELoc);
+      ReductionOp = CallExpr::Create(Context, OVE, Args, Context.VoidTy,
+                                     VK_RValue, ELoc);
     } else {
       ReductionOp = BuildBinOp(DSAStack->getCurScope(),
                                ReductionId.getLocStart(), BOK, LHSDRE, RHSDRE);
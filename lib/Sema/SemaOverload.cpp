@@ -4863,6 +4863,96 @@ TryCopyInitialization(Sema &S, Expr *From, QualType ToType,
                                /*AllowObjCConversionOnExplicit=*/false);
 }
 
+/// \brief Determine whether converting an argument of class type to the
+/// given parameter type can be decided from the types alone, and whether
+/// that decision is final for the rest of the translation unit.
+///
+/// This is the case when both the argument's class and the parameter type
+/// are complete: no later declaration can add a constructor or conversion
+/// function, and nothing about the particular expression (null pointer
+/// constants, bit-fields, string literals, initializer lists, overload sets)
+/// matters for a class-typed argument.
+static bool isCacheableCandidateConversion(Sema &S, Expr *From,
+                                           QualType ToType) {
+  if (!S.getLangOpts().CPlusPlus || From->hasPlaceholderType() ||
+      From->getObjectKind() != OK_Ordinary)
+    return false;
+
+  QualType FromType = From->getType();
+  if (!FromType->isRecordType() || FromType->isIncompleteType())
+    return false;
+
+  QualType To = ToType.getNonReferenceType();
+  if (To->isDependentType() || To->isIncompleteType())
+    return false;
+  return To->isRecordType() || To->isArithmeticType();
+}
+
+/// \brief Determine whether converting an argument of class type to the
+/// given parameter type obviously fails, without performing overload
+/// resolution over conversion functions: a class with no conversion
+/// functions cannot be converted to a scalar.
+static bool isObviouslyBadCandidateConversion(Sema &S, Expr *From,
+                                              QualType ToType) {
+  if (!S.getLangOpts().CPlusPlus || From->hasPlaceholderType())
+    return false;
+
+  if (!ToType->isScalarType() || ToType->isDependentType())
+    return false;
+
+  CXXRecordDecl *FromRD = From->getType()->getAsCXXRecordDecl();
+  if (!FromRD || !FromRD->hasDefinition() || FromRD->isBeingDefined())
+    return false;
+
+  auto Conversions = FromRD->getVisibleConversionFunctions();
+  return Conversions.begin() == Conversions.end();
+}
+
+/// TryCopyInitializationForCandidate - Compute the implicit conversion
+/// sequence for passing the argument From to a parameter of type ToType of an
+/// overload candidate, as \c TryCopyInitialization does, but skipping
+/// conversions that obviously fail and reusing earlier results for
+/// arguments of class type.
+static ImplicitConversionSequence
+TryCopyInitializationForCandidate(Sema &S, Expr *From, QualType ToType,
+                                  bool SuppressUserConversions,
+                                  bool AllowExplicit) {
+  ImplicitConversionSequence ICS;
+  if (isObviouslyBadCandidateConversion(S, From, ToType)) {
+    ICS.setBad(BadConversionSequence::no_conversion, From, ToType);
+    return ICS;
+  }
+
+  bool AllowObjCWriteback = S.getLangOpts().ObjCAutoRefCount;
+  if (!isCacheableCandidateConversion(S, From, ToType))
+    return TryCopyInitialization(S, From, ToType, SuppressUserConversions,
+                                 /*InOverloadResolution=*/true,
+                                 AllowObjCWriteback, AllowExplicit);
+
+  if (!S.CandidateConversions)
+    S.CandidateConversions.reset(new ConversionSequenceCache());
+
+  QualType FromType = S.Context.getCanonicalType(From->getType());
+  QualType CanonToType = S.Context.getCanonicalType(ToType);
+  unsigned Flags = SuppressUserConversions | (AllowExplicit << 1) |
+                   (AllowObjCWriteback << 2);
+  if (const ImplicitConversionSequence *Known = S.CandidateConversions->lookup(
+          FromType, From->getValueKind(), CanonToType, Flags)) {
+    ICS = *Known;
+    if (ICS.isBad())
+      ICS.Bad.setFromExpr(From);
+    return ICS;
+  }
+
+  ICS = TryCopyInitialization(S, From, ToType, SuppressUserConversions,
+                              /*InOverloadResolution=*/true,
+                              AllowObjCWriteback, AllowExplicit);
+  if (!ICS.isAmbiguous())
+    S.CandidateConversions->insert(FromType, From->getValueKind(),
+                                   CanonToType, Flags, ICS);
+  return ICS;
+}
+
 static bool TryCopyInitialization(const CanQualType FromQTy,
                                   const CanQualType ToQTy,
                                   Sema &S,
@@ -5862,12 +5952,9 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
       // parameter of F.
       QualType ParamType = Proto->getParamType(ArgIdx);
       Candidate.Conversions[ArgIdx]
-        = TryCopyInitialization(*this, Args[ArgIdx], ParamType,
-                                SuppressUserConversions,
-                                /*InOverloadResolution=*/true,
-                                /*AllowObjCWritebackConversion=*/
-                                  getLangOpts().ObjCAutoRefCount,
-                                AllowExplicit);
+        = TryCopyInitializationForCandidate(*this, Args[ArgIdx], ParamType,
+                                            SuppressUserConversions,
+                                            AllowExplicit);
       if (Candidate.Conversions[ArgIdx].isBad()) {
         Candidate.Viable = false;
         Candidate.FailureKind = ovl_fail_bad_conversion;
@@ -6248,11 +6335,9 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
       // parameter of F.
       QualType ParamType = Proto->getParamType(ArgIdx);
       Candidate.Conversions[ArgIdx + 1]
-        = TryCopyInitialization(*this, Args[ArgIdx], ParamType,
-                                SuppressUserConversions,
-                                /*InOverloadResolution=*/true,
-                                /*AllowObjCWritebackConversion=*/
-                                  getLangOpts().ObjCAutoRefCount);
+        = TryCopyInitializationForCandidate(*this, Args[ArgIdx], ParamType,
+                                            SuppressUserConversions,
+                                            /*AllowExplicit=*/false);
       if (Candidate.Conversions[ArgIdx + 1].isBad()) {
         Candidate.Viable = false;
         Candidate.FailureKind = ovl_fail_bad_conversion;
@@ -6525,14 +6610,16 @@ Sema::AddConversionCandidate(CXXConversionDecl *Conversion,
 
   ExprValueKind VK = Expr::getValueKindForType(ConversionType);
 
-  // Note that it is safe to allocate CallExpr on the stack here because
-  // there are 0 arguments (i.e., nothing is allocated using ASTContext's
-  // allocator).
+  // Note that it is safe to build the CallExpr on the stack here because
+  // it has no arguments, so its storage has a fixed size (the call and its
+  // callee).
   QualType CallResultType = ConversionType.getNonLValueExprType(Context);
-  CallExpr Call(Context, &ConversionFn, None, CallResultType, VK,
-                From->getLocStart());
+  llvm::AlignedCharArray<llvm::AlignOf<CallExpr>::Alignment,
+                         sizeof(CallExpr) + sizeof(Stmt *)> Buffer;
+  CallExpr *TheTemporaryCall = CallExpr::CreateTemporary(
+      Buffer.buffer, &ConversionFn, CallResultType, VK, From->getLocStart());
   ImplicitConversionSequence ICS =
-    TryCopyInitialization(*this, &Call, ToType,
+    TryCopyInitialization(*this, TheTemporaryCall, ToType,
                           /*SuppressUserConversions=*/true,
                           /*InOverloadResolution=*/false,
                           /*AllowObjCWritebackConversion=*/false);
@@ -11389,7 +11476,7 @@ bool Sema::buildOverloadedCallSet(Scope *S, Expr *Fn,
       // create a type dependent CallExpr. The goal is to postpone name lookup
       // to instantiation time to be able to search into type dependent base
       // classes.
-      CallExpr *CE = new (Context) CallExpr(
+      CallExpr *CE = CallExpr::Create(
           Context, Fn, Args, Context.DependentTy, VK_RValue, RParenLoc);
       CE->setTypeDependent(true);
       CE->setValueDependent(true);
@@ -11600,9 +11687,9 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, UnaryOperatorKind Opc,
                                      NestedNameSpecifierLoc(), OpNameInfo,
                                      /*ADL*/ true, IsOverloaded(Fns),
                                      Fns.begin(), Fns.end());
-    return new (Context)
-        CXXOperatorCallExpr(Context, Op, Fn, ArgsArray, Context.DependentTy,
-                            VK_RValue, OpLoc, false);
+    return CXXOperatorCallExpr::Create(Context, Op, Fn, ArgsArray,
+                                       Context.DependentTy, VK_RValue, OpLoc,
+                                       false);
   }
 
   // Build an empty overload set.
@@ -11671,8 +11758,8 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, UnaryOperatorKind Opc,
 
       Args[0] = Input;
       CallExpr *TheCall =
-        new (Context) CXXOperatorCallExpr(Context, Op, FnExpr.get(), ArgsArray,
-                                          ResultTy, VK, OpLoc, false);
+        CXXOperatorCallExpr::Create(Context, Op, FnExpr.get(), ArgsArray,
+                                    ResultTy, VK, OpLoc, false);
 
       if (CheckCallReturnType(FnDecl->getReturnType(), OpLoc, TheCall, FnDecl))
         return ExprError();
@@ -11783,9 +11870,9 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
                                      NestedNameSpecifierLoc(), OpNameInfo, 
                                      /*ADL*/ true, IsOverloaded(Fns),
                                      Fns.begin(), Fns.end());
-    return new (Context)
-        CXXOperatorCallExpr(Context, Op, Fn, Args, Context.DependentTy,
-                            VK_RValue, OpLoc, FPFeatures.fp_contract);
+    return CXXOperatorCallExpr::Create(Context, Op, Fn, Args,
+                                       Context.DependentTy, VK_RValue, OpLoc,
+                                       FPFeatures.fp_contract);
   }
 
   // Always do placeholder-like conversions on the RHS.
@@ -11898,9 +11985,9 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
         ResultTy = ResultTy.getNonLValueExprType(Context);
 
         CXXOperatorCallExpr *TheCall =
-          new (Context) CXXOperatorCallExpr(Context, Op, FnExpr.get(),
-                                            Args, ResultTy, VK, OpLoc,
-                                            FPFeatures.fp_contract);
+          CXXOperatorCallExpr::Create(Context, Op, FnExpr.get(),
+                                      Args, ResultTy, VK, OpLoc,
+                                      FPFeatures.fp_contract);
 
         if (CheckCallReturnType(FnDecl->getReturnType(), OpLoc, TheCall,
                                 FnDecl))
@@ -12042,9 +12129,9 @@ Sema::CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
                                      UnresolvedSetIterator());
     // Can't add any actual overloads yet
 
-    return new (Context)
-        CXXOperatorCallExpr(Context, OO_Subscript, Fn, Args,
-                            Context.DependentTy, VK_RValue, RLoc, false);
+    return CXXOperatorCallExpr::Create(Context, OO_Subscript, Fn, Args,
+                                       Context.DependentTy, VK_RValue, RLoc,
+                                       false);
   }
 
   // Handle placeholders on both operands.
@@ -12117,10 +12204,10 @@ Sema::CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
         ResultTy = ResultTy.getNonLValueExprType(Context);
 
         CXXOperatorCallExpr *TheCall =
-          new (Context) CXXOperatorCallExpr(Context, OO_Subscript,
-                                            FnExpr.get(), Args,
-                                            ResultTy, VK, RLoc,
-                                            false);
+          CXXOperatorCallExpr::Create(Context, OO_Subscript,
+                                      FnExpr.get(), Args,
+                                      ResultTy, VK, RLoc,
+                                      false);
 
         if (CheckCallReturnType(FnDecl->getReturnType(), LLoc, TheCall, FnDecl))
           return ExprError();
@@ -12237,8 +12324,9 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
     }
 
     CXXMemberCallExpr *call
-      = new (Context) CXXMemberCallExpr(Context, MemExprE, Args,
-                                        resultType, valueKind, RParenLoc);
+      = CXXMemberCallExpr::Create(Context, MemExprE, Args,
+                                  resultType, valueKind, RParenLoc,
+                                  /*MinNumArgs=*/proto->getNumParams());
 
     if (CheckCallReturnType(proto->getReturnType(), op->getRHS()->getLocStart(),
                             call, nullptr))
@@ -12254,8 +12342,8 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
   }
 
   if (isa<CXXPseudoDestructorExpr>(NakedMemExpr))
-    return new (Context)
-        CallExpr(Context, MemExprE, Args, Context.VoidTy, VK_RValue, RParenLoc);
+    return CallExpr::Create(Context, MemExprE, Args, Context.VoidTy, VK_RValue,
+                            RParenLoc);
 
   UnbridgedCastsSet UnbridgedCasts;
   if (checkArgPlaceholdersForOverload(*this, Args, UnbridgedCasts))
@@ -12390,8 +12478,9 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
 
   assert(Method && "Member call to something that isn't a method?");
   CXXMemberCallExpr *TheCall =
-    new (Context) CXXMemberCallExpr(Context, MemExprE, Args,
-                                    ResultType, VK, RParenLoc);
+    CXXMemberCallExpr::Create(Context, MemExprE, Args,
+                              ResultType, VK, RParenLoc,
+                              /*MinNumArgs=*/Method->getNumParams());
 
   // Check for a valid return type.
   if (CheckCallReturnType(Method->getReturnType(), MemExpr->getMemberLoc(),
@@ -12679,19 +12768,19 @@ Sema::BuildCallToObjectOfClassType(Scope *S, Expr *Obj,
   ExprValueKind VK = Expr::getValueKindForType(ResultTy);
   ResultTy = ResultTy.getNonLValueExprType(Context);
 
-  CXXOperatorCallExpr *TheCall = new (Context)
-      CXXOperatorCallExpr(Context, OO_Call, NewFn.get(),
-                          llvm::makeArrayRef(MethodArgs.get(), Args.size() + 1),
-                          ResultTy, VK, RParenLoc, false);
+  CXXOperatorCallExpr *TheCall = CXXOperatorCallExpr::Create(
+      Context, OO_Call, NewFn.get(),
+      llvm::makeArrayRef(MethodArgs.get(), Args.size() + 1), ResultTy, VK,
+      RParenLoc, false, /*MinNumArgs=*/NumParams + 1);
   MethodArgs.reset();
 
   if (CheckCallReturnType(Method->getReturnType(), LParenLoc, TheCall, Method))
     return true;
 
-  // We may have default arguments. If so, we need to allocate more
-  // slots in the call for them.
+  // We may have default arguments. If so, they go in the slots that were
+  // reserved for them when the call was built.
   if (Args.size() < NumParams)
-    TheCall->setNumArgs(Context, NumParams + 1);
+    TheCall->setNumArgsUnsafe(NumParams + 1);
 
   bool IsError = false;
 
@@ -12862,8 +12951,8 @@ Sema::BuildOverloadedArrowExpr(Scope *S, Expr *Base, SourceLocation OpLoc,
   ExprValueKind VK = Expr::getValueKindForType(ResultTy);
   ResultTy = ResultTy.getNonLValueExprType(Context);
   CXXOperatorCallExpr *TheCall =
-    new (Context) CXXOperatorCallExpr(Context, OO_Arrow, FnExpr.get(),
-                                      Base, ResultTy, VK, OpLoc, false);
+    CXXOperatorCallExpr::Create(Context, OO_Arrow, FnExpr.get(),
+                                Base, ResultTy, VK, OpLoc, false);
 
   if (CheckCallReturnType(Method->getReturnType(), OpLoc, TheCall, Method))
           return ExprError();
@@ -12932,9 +13021,9 @@ ExprResult Sema::BuildLiteralOperatorCall(LookupResult &R,
   ResultTy = ResultTy.getNonLValueExprType(Context);
 
   UserDefinedLiteral *UDL =
-    new (Context) UserDefinedLiteral(Context, Fn.get(),
-                                     llvm::makeArrayRef(ConvArgs, Args.size()),
-                                     ResultTy, VK, LitEndLoc, UDSuffixLoc);
+    UserDefinedLiteral::Create(Context, Fn.get(),
+                               llvm::makeArrayRef(ConvArgs, Args.size()),
+                               ResultTy, VK, LitEndLoc, UDSuffixLoc);
 
   if (CheckCallReturnType(FD->getReturnType(), UDSuffixLoc, UDL, FD))
     return ExprError();
@@ -3355,6 +3355,59 @@ DeduceTemplateArgumentByListElement(Sema &S,
                                             ArgType, Info, Deduced, TDF);
 }
 
+/// \brief Compute the key under which the result of deducing the template
+/// arguments of a call to \p FunctionTemplate is cached.
+///
+/// \returns false if the result of the deduction may depend on more than the
+/// explicit template arguments and the types and value kinds of the call
+/// arguments, in which case it must not be cached.
+static bool
+getDeducedSpecializationKey(Sema &S, FunctionTemplateDecl *FunctionTemplate,
+                            TemplateArgumentListInfo *ExplicitTemplateArgs,
+                            ArrayRef<Expr *> Args, llvm::FoldingSetNodeID &ID) {
+  // In a SFINAE context, errors that would otherwise be diagnosed while
+  // substituting into the specialization instead cause deduction to fail
+  // further up; don't let such deductions populate the cache.
+  if (S.isSFINAEContext() || FunctionTemplate->isInvalidDecl())
+    return false;
+
+  ID.AddPointer(FunctionTemplate->getCanonicalDecl());
+
+  // Deduction and the substitution of deduced arguments happen in the context
+  // of the template, so a deduction without explicit template arguments can
+  // be reused anywhere. Explicit template arguments, however, are substituted
+  // and access checked in the context of the call, where a friend of a class
+  // may be able to name a member that others cannot; substitution failures
+  // are not cached, but a success must only be reused from a context with
+  // the same access.
+  if (ExplicitTemplateArgs) {
+    ID.AddPointer(S.CurContext);
+    ID.AddInteger(ExplicitTemplateArgs->size() + 1);
+    for (const TemplateArgumentLoc &Loc : ExplicitTemplateArgs->arguments()) {
+      const TemplateArgument &Arg = Loc.getArgument();
+      if (Arg.isInstantiationDependent() ||
+          Arg.containsUnexpandedParameterPack())
+        return false;
+      Arg.Profile(ID, S.Context);
+    }
+  } else {
+    ID.AddInteger(0);
+  }
+
+  ID.AddInteger(Args.size());
+  for (Expr *Arg : Args) {
+    // Deduction from overload sets and initializer lists looks at the
+    // argument expression itself, and deduction from an array of unknown
+    // bound may complete its type.
+    if (Arg->isTypeDependent() || Arg->hasPlaceholderType() ||
+        isa<InitListExpr>(Arg) || Arg->getType()->isIncompleteArrayType())
+      return false;
+    ID.AddPointer(S.Context.getCanonicalType(Arg->getType()).getAsOpaquePtr());
+    ID.AddInteger(Arg->getValueKind());
+  }
+  return true;
+}
+
 /// \brief Perform template argument deduction from a function call
 /// (C++ [temp.deduct.call]).
 ///
@@ -3379,6 +3432,42 @@ Sema::TemplateDeductionResult Sema::DeduceTemplateArguments(
     TemplateArgumentListInfo *ExplicitTemplateArgs, ArrayRef<Expr *> Args,
     FunctionDecl *&Specialization, TemplateDeductionInfo &Info,
     bool PartialOverloading) {
+  llvm::FoldingSetNodeID ID;
+  if (PartialOverloading ||
+      !getDeducedSpecializationKey(*this, FunctionTemplate,
+                                   ExplicitTemplateArgs, Args, ID))
+    return DeduceTemplateArgumentsFromCall(FunctionTemplate,
+                                           ExplicitTemplateArgs, Args,
+                                           Specialization, Info,
+                                           PartialOverloading);
+
+  if (!DeducedSpecializations)
+    DeducedSpecializations.reset(new DeducedSpecializationCache());
+
+  if (FunctionDecl *Known = DeducedSpecializations->lookup(ID)) {
+    Specialization = Known;
+    Info.reset(TemplateArgumentList::CreateCopy(
+        Context, Known->getTemplateSpecializationArgs()->asArray()));
+    return TDK_Success;
+  }
+
+  // Errors diagnosed during deduction (for instance, while instantiating a
+  // class template needed to match an argument) are not repeated on a cache
+  // hit, so only remember deductions that did not produce any.
+  DiagnosticErrorTrap Trap(Diags);
+  TemplateDeductionResult Result = DeduceTemplateArgumentsFromCall(
+      FunctionTemplate, ExplicitTemplateArgs, Args, Specialization, Info,
+      PartialOverloading);
+  if (Result == TDK_Success && !Trap.hasErrorOccurred())
+    DeducedSpecializations->insert(ID, Specialization);
+  return Result;
+}
+
+Sema::TemplateDeductionResult Sema::DeduceTemplateArgumentsFromCall(
+    FunctionTemplateDecl *FunctionTemplate,
+    TemplateArgumentListInfo *ExplicitTemplateArgs, ArrayRef<Expr *> Args,
+    FunctionDecl *&Specialization, TemplateDeductionInfo &Info,
+    bool PartialOverloading) {
   if (FunctionTemplate->isInvalidDecl())
     return TDK_Invalid;
 
@@ -15,6 +15,7 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTLambda.h"
+#include "clang/AST/ASTMemoryAccounting.h"
 #include "clang/AST/ASTMutationListener.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
@@ -25,6 +26,7 @@
 #include "clang/Sema/PrettyDeclStackTrace.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 
 using namespace clang;
 using namespace sema;
@@ -234,6 +236,11 @@ Sema::InstantiatingTemplate::InstantiatingTemplate(
     SemaRef.ActiveTemplateInstantiations.push_back(Inst);
     if (!Inst.isInstantiationRecord())
       ++SemaRef.NonInstantiationEntries;
+    if (SemaRef.TemplateProfiler)
+      SemaRef.TemplateProfiler->startInstantiation(Inst);
+    if (ASTMemoryAccounting *Accounting =
+            SemaRef.Context.getMemoryAccounting())
+      Accounting->pushInstantiation(Inst.Entity->getCanonicalDecl());
   }
 }
 
@@ -360,6 +367,12 @@ void Sema::InstantiatingTemplate::Clear() {
       SemaRef.InstantiatingSpecializations.erase(
           std::make_pair(Active.Entity, Active.Kind));
 
+    if (SemaRef.TemplateProfiler)
+      SemaRef.TemplateProfiler->finishInstantiation();
+    if (ASTMemoryAccounting *Accounting =
+            SemaRef.Context.getMemoryAccounting())
+      Accounting->popInstantiation();
+
     SemaRef.ActiveTemplateInstantiations.pop_back();
     Invalid = true;
   }
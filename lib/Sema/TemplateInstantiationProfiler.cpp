@@ -0,0 +1,224 @@
+//===- TemplateInstantiationProfiler.cpp - Template cost profile ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the TemplateInstantiationProfiler class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/TemplateInstantiationProfiler.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace clang;
+
+typedef Sema::ActiveTemplateInstantiation ActiveInst;
+
+static double getCurrentTime() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+TemplateInstantiationProfiler::TemplateInstantiationProfiler(
+    ASTContext &Context)
+    : Context(Context) {
+  // Node 0 is the root of the tree of instantiation stacks.
+  Nodes.push_back(StackNode{KeyType(), 0, 0, {}});
+}
+
+/// \brief Map a specialization to the template (or member of a class
+/// template) it was instantiated from, so that costs can be aggregated per
+/// template.
+TemplateInstantiationProfiler::KeyType
+TemplateInstantiationProfiler::getTemplateKey(KeyType Key) {
+  const Decl *D = Key.first;
+  const Decl *Pattern = nullptr;
+
+  if (auto *Spec = dyn_cast<ClassTemplateSpecializationDecl>(D))
+    Pattern = Spec->getSpecializedTemplate();
+  else if (auto *Spec = dyn_cast<VarTemplateSpecializationDecl>(D))
+    Pattern = Spec->getSpecializedTemplate();
+  else if (auto *FD = dyn_cast<FunctionDecl>(D)) {
+    if (FunctionTemplateDecl *Primary = FD->getPrimaryTemplate())
+      Pattern = Primary;
+    else
+      Pattern = FD->getInstantiatedFromMemberFunction();
+  } else if (auto *RD = dyn_cast<CXXRecordDecl>(D))
+    Pattern = RD->getInstantiatedFromMemberClass();
+  else if (auto *ED = dyn_cast<EnumDecl>(D))
+    Pattern = ED->getInstantiatedFromMemberEnum();
+  else if (auto *VD = dyn_cast<VarDecl>(D))
+    Pattern = VD->getInstantiatedFromStaticDataMember();
+
+  if (Pattern)
+    Pattern = Pattern->getCanonicalDecl();
+  return KeyType(Pattern ? Pattern : D, Key.second);
+}
+
+std::string TemplateInstantiationProfiler::getName(KeyType Key,
+                                                   bool WithArgs) const {
+  std::string Name;
+  llvm::raw_string_ostream OS(Name);
+
+  // Default function arguments are named after their function.
+  const Decl *D = Key.first;
+  if (isa<ParmVarDecl>(D) && isa<FunctionDecl>(D->getDeclContext()))
+    D = cast<FunctionDecl>(D->getDeclContext());
+
+  if (auto *ND = dyn_cast<NamedDecl>(D)) {
+    if (WithArgs)
+      ND->getNameForDiagnostic(OS, Context.getPrintingPolicy(),
+                               /*Qualified=*/true);
+    else
+      ND->printQualifiedName(OS);
+  } else {
+    OS << D->getDeclKindName();
+  }
+
+  switch ((KindType)Key.second) {
+  case ActiveInst::TemplateInstantiation:
+    break;
+  case ActiveInst::DefaultTemplateArgumentInstantiation:
+    OS << " (default template argument)";
+    break;
+  case ActiveInst::DefaultFunctionArgumentInstantiation:
+    OS << " (default function argument)";
+    break;
+  case ActiveInst::ExplicitTemplateArgumentSubstitution:
+    OS << " (explicit argument substitution)";
+    break;
+  case ActiveInst::DeducedTemplateArgumentSubstitution:
+    OS << " (deduction)";
+    break;
+  case ActiveInst::PriorTemplateArgumentSubstitution:
+    OS << " (prior argument substitution)";
+    break;
+  case ActiveInst::DefaultTemplateArgumentChecking:
+    OS << " (default argument checking)";
+    break;
+  case ActiveInst::ExceptionSpecInstantiation:
+    OS << " (exception specification)";
+    break;
+  }
+
+  return OS.str();
+}
+
+void TemplateInstantiationProfiler::startInstantiation(
+    const ActiveInst &Inst) {
+  ++NumInstantiations;
+
+  Frame F;
+  F.Key = KeyType(Inst.Entity->getCanonicalDecl(), Inst.Kind);
+  F.TemplateKey = getTemplateKey(F.Key);
+  ++KeysOnStack[F.Key];
+  ++TemplatesOnStack[F.TemplateKey];
+
+  // Find or create the node for this stack of instantiations.
+  unsigned Parent = Stack.empty() ? 0 : Stack.back().Node;
+  auto Known = Nodes[Parent].Children.find(F.Key);
+  if (Known != Nodes[Parent].Children.end()) {
+    F.Node = Known->second;
+  } else {
+    F.Node = Nodes.size();
+    Nodes[Parent].Children[F.Key] = F.Node;
+    Nodes.push_back(StackNode{F.Key, Parent, 0, {}});
+  }
+
+  F.ChildTime = 0;
+  F.StartBytes = Context.getAllocator().getBytesAllocated();
+  F.StartCount = NumInstantiations;
+  F.StartTime = getCurrentTime();
+  Stack.push_back(F);
+}
+
+void TemplateInstantiationProfiler::finishInstantiation() {
+  assert(!Stack.empty() && "no instantiation in progress");
+  double Now = getCurrentTime();
+  Frame F = Stack.pop_back_val();
+
+  double Elapsed = Now - F.StartTime;
+  double Self = Elapsed - F.ChildTime;
+  uint64_t Bytes = Context.getAllocator().getBytesAllocated() - F.StartBytes;
+  unsigned Nested = NumInstantiations - F.StartCount;
+
+  Nodes[F.Node].SelfTime += Self;
+  if (Stack.empty())
+    TotalTime += Elapsed;
+  else
+    Stack.back().ChildTime += Elapsed;
+
+  // Inclusive costs are only attributed to the outermost occurrence of a
+  // key, so that recursive instantiations are not counted several times.
+  auto Attribute = [&](Cost &C, bool Outermost) {
+    ++C.Count;
+    C.SelfTime += Self;
+    if (Outermost) {
+      C.Time += Elapsed;
+      C.Nested += Nested;
+      C.Bytes += Bytes;
+    }
+  };
+  Attribute(Specializations[F.Key], --KeysOnStack[F.Key] == 0);
+  Attribute(Templates[F.TemplateKey], --TemplatesOnStack[F.TemplateKey] == 0);
+}
+
+void TemplateInstantiationProfiler::printReport(llvm::raw_ostream &OS,
+                                                unsigned MaxEntries) const {
+  typedef std::pair<KeyType, Cost> Entry;
+  auto PrintTable = [&](const char *Title,
+                        const llvm::DenseMap<KeyType, Cost> &Costs,
+                        bool WithArgs) {
+    std::vector<Entry> Sorted(Costs.begin(), Costs.end());
+    std::sort(Sorted.begin(), Sorted.end(),
+              [](const Entry &X, const Entry &Y) {
+                return X.second.Time > Y.second.Time;
+              });
+    if (Sorted.size() > MaxEntries)
+      Sorted.resize(MaxEntries);
+
+    OS << "  " << Title << " (top " << Sorted.size() << " of " << Costs.size()
+       << ", by total time):\n";
+    OS << "     Total(s)    Self(s)   Count  Nested      Bytes  Name\n";
+    for (const Entry &E : Sorted) {
+      const Cost &C = E.second;
+      OS << llvm::format("  %11.6f %10.6f %7u %7u %10llu  ", C.Time,
+                         C.SelfTime, C.Count, C.Nested,
+                         (unsigned long long)C.Bytes)
+         << getName(E.first, WithArgs) << '\n';
+    }
+  };
+
+  OS << "\n*** Template Instantiation Profile:\n";
+  OS << "  " << NumInstantiations << " template instantiations, "
+     << llvm::format("%.6f", TotalTime) << " seconds\n";
+  PrintTable("Templates", Templates, /*WithArgs=*/false);
+  PrintTable("Specializations", Specializations, /*WithArgs=*/true);
+}
+
+void TemplateInstantiationProfiler::printFoldedStacks(
+    llvm::raw_ostream &OS) const {
+  SmallVector<unsigned, 16> Path;
+  for (unsigned I = 1, N = Nodes.size(); I != N; ++I) {
+    Path.clear();
+    for (unsigned Node = I; Node; Node = Nodes[Node].Parent)
+      Path.push_back(Node);
+
+    for (unsigned J = Path.size(); J; --J) {
+      std::string Name = getName(Nodes[Path[J - 1]].Key, /*WithArgs=*/true);
+      std::replace(Name.begin(), Name.end(), ';', ',');
+      OS << Name << (J == 1 ? ' ' : ';');
+    }
+    OS << (uint64_t)(Nodes[I].SelfTime * 1e6) << '\n';
+  }
+}
@@ -27,6 +27,7 @@
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/NestedNameSpecifier.h"
 #include "clang/AST/RawCommentList.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
 #include "clang/AST/UnresolvedSet.h"
@@ -60,6 +61,7 @@
 #include "clang/Sema/Weak.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
+#include "clang/Serialization/ModuleBufferCache.h"
 #include "clang/Serialization/ModuleManager.h"
 #include "clang/Serialization/SerializationDiagnostic.h"
 #include "llvm/ADT/APFloat.h"
@@ -190,16 +192,20 @@ void ChainedASTReaderListener::visitModuleFile(StringRef Filename,
 bool ChainedASTReaderListener::visitInputFile(StringRef Filename,
                                               bool isSystem,
                                               bool isOverridden,
-                                              bool isExplicitModule) {
+                                              bool isExplicitModule,
+                                              off_t StoredSize,
+                                              time_t StoredTime) {
   bool Continue = false;
   if (First->needsInputFileVisitation() &&
       (!isSystem || First->needsSystemInputFileVisitation()))
     Continue |= First->visitInputFile(Filename, isSystem, isOverridden,
-                                      isExplicitModule);
+                                      isExplicitModule, StoredSize,
+                                      StoredTime);
   if (Second->needsInputFileVisitation() &&
       (!isSystem || Second->needsSystemInputFileVisitation()))
     Continue |= Second->visitInputFile(Filename, isSystem, isOverridden,
-                                       isExplicitModule);
+                                       isExplicitModule, StoredSize,
+                                       StoredTime);
   return Continue;
 }
 
@@ -1042,6 +1048,24 @@ void ASTDeclContextNameLookupTrait::ReadDataInto(internal_key_type,
   }
 }
 
+/// \brief Decompress a blob written by ASTWriter::compressBlob.
+///
+/// The decompressed data is owned by the module file, so that the on-disk
+/// tables and arrays that point into it remain valid for the module's
+/// lifetime. Returns an empty string on failure.
+static StringRef decompressBlob(ModuleFile &F, StringRef Blob,
+                                uint64_t UncompressedSize) {
+  SmallString<0> Uncompressed;
+  if (!UncompressedSize ||
+      llvm::zlib::uncompress(Blob, Uncompressed, UncompressedSize) !=
+          llvm::zlib::StatusOK)
+    return StringRef();
+
+  F.DecompressedBlobs.push_back(
+      llvm::MemoryBuffer::getMemBufferCopy(Uncompressed));
+  return F.DecompressedBlobs.back()->getBuffer();
+}
+
 bool ASTReader::ReadLexicalDeclContextStorage(ModuleFile &M,
                                               BitstreamCursor &Cursor,
                                               uint64_t Offset,
@@ -1055,7 +1079,8 @@ bool ASTReader::ReadLexicalDeclContextStorage(ModuleFile &M,
   StringRef Blob;
   unsigned Code = Cursor.ReadCode();
   unsigned RecCode = Cursor.readRecord(Code, Record, &Blob);
-  if (RecCode != DECL_CONTEXT_LEXICAL) {
+  if (RecCode != DECL_CONTEXT_LEXICAL &&
+      RecCode != DECL_CONTEXT_LEXICAL_COMPRESSED) {
     Error("Expected lexical block");
     return true;
   }
@@ -1068,6 +1093,13 @@ bool ASTReader::ReadLexicalDeclContextStorage(ModuleFile &M,
   // see.
   auto &Lex = LexicalDecls[DC];
   if (!Lex.first) {
+    if (RecCode == DECL_CONTEXT_LEXICAL_COMPRESSED) {
+      Blob = decompressBlob(M, Blob, Record[0]);
+      if (Blob.empty()) {
+        Error("could not decompress lexical block");
+        return true;
+      }
+    }
     Lex = std::make_pair(
         &M, llvm::makeArrayRef(
                 reinterpret_cast<const llvm::support::unaligned_uint32_t *>(
@@ -1099,7 +1131,8 @@ bool ASTReader::ReadVisibleDeclContextStorage(ModuleFile &M,
   // We can't safely determine the primary context yet, so delay attaching the
   // lookup table until we're done with recursive deserialization.
   auto *Data = (const unsigned char*)Blob.data();
-  PendingVisibleUpdates[ID].push_back(PendingVisibleUpdate{&M, Data});
+  PendingVisibleUpdates[ID].push_back(
+      PendingVisibleUpdate{&M, Data, Blob.size()});
   return false;
 }
 
@@ -2286,7 +2319,8 @@ ASTReader::ReadControlBlock(ModuleFile &F,
           InputFileInfo FI = readInputFileInfo(F, I+1);
           Listener->visitInputFile(FI.Filename, IsSystem, FI.Overridden,
                                    F.Kind == MK_ExplicitModule ||
-                                   F.Kind == MK_PrebuiltModule);
+                                   F.Kind == MK_PrebuiltModule,
+                                   FI.StoredSize, FI.StoredTime);
         }
       }
 
@@ -2700,7 +2734,8 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       unsigned Idx = 0;
       serialization::DeclID ID = ReadDeclID(F, Record, Idx);
       auto *Data = (const unsigned char*)Blob.data();
-      PendingVisibleUpdates[ID].push_back(PendingVisibleUpdate{&F, Data});
+      PendingVisibleUpdates[ID].push_back(
+          PendingVisibleUpdate{&F, Data, Blob.size()});
       // If we've already loaded the decl, perform the updates when we finish
       // loading this block.
       if (Decl *D = GetExistingDecl(ID))
@@ -2708,6 +2743,14 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       break;
     }
 
+    case IDENTIFIER_TABLE_COMPRESSED:
+      Blob = decompressBlob(F, Blob, Record[1]);
+      if (Blob.empty()) {
+        Error("could not decompress identifier table");
+        return Failure;
+      }
+      // Fall through.
+
     case IDENTIFIER_TABLE:
       F.IdentifierTableData = Blob.data();
       if (Record[0]) {
@@ -3188,6 +3231,13 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
             ReadSourceLocation(F, Record, I).getRawEncoding());
       }
       break;
+    case RECORD_LAYOUTS:
+      F.RecordLayoutData.assign(Record.begin(), Record.end());
+      for (unsigned I = 0, N = Record.size(); I + 1 < N; I += 2 + Record[I + 1])
+        F.RecordLayoutOffsets[getGlobalDeclID(F, Record[I])] = I + 2;
+      TotalRecordLayouts += F.RecordLayoutOffsets.size();
+      break;
+
     case DELETE_EXPRS_TO_ANALYZE:
       for (unsigned I = 0, N = Record.size(); I != N;) {
         DelayedDeleteExprs.push_back(getGlobalDeclID(F, Record[I++]));
@@ -4419,11 +4469,14 @@ bool ASTReader::readASTFileControlBlock(
         bool shouldContinue = false;
         switch ((InputFileRecordTypes)Cursor.readRecord(Code, Record, &Blob)) {
         case INPUT_FILE:
+          off_t StoredSize = static_cast<off_t>(Record[1]);
+          time_t StoredTime = static_cast<time_t>(Record[2]);
           bool Overridden = static_cast<bool>(Record[3]);
           std::string Filename = Blob;
           ResolveImportedPath(Filename, ModuleDir);
           shouldContinue = Listener.visitInputFile(
-              Filename, isSystemFile, Overridden, /*IsExplicitModule*/false);
+              Filename, isSystemFile, Overridden, /*IsExplicitModule*/false,
+              StoredSize, StoredTime);
           break;
         }
         if (!shouldContinue)
@@ -6511,6 +6564,75 @@ bool ASTReader::isDeclIDFromModule(serialization::GlobalDeclID ID,
          ID - NUM_PREDEF_DECL_IDS < M.BaseDeclID + M.LocalNumDecls;
 }
 
+const ASTRecordLayout *
+ASTReader::getStoredRecordLayout(const RecordDecl *Record) {
+  ModuleFile *F = getOwningModuleFile(Record);
+  if (!F)
+    return nullptr;
+  auto Pos = F->RecordLayoutOffsets.find(Record->getGlobalID());
+  if (Pos == F->RecordLayoutOffsets.end())
+    return nullptr;
+
+  // See ASTWriter::AddRecordLayout for the format.
+  const uint64_t *Data = F->RecordLayoutData.data() + Pos->second;
+  unsigned Idx = 0;
+  auto ReadCharUnits = [&] {
+    return CharUnits::fromQuantity(static_cast<int64_t>(Data[Idx++]));
+  };
+  auto ReadRecord = [&]() -> const CXXRecordDecl * {
+    serialization::DeclID ID = getGlobalDeclID(*F, Data[Idx++]);
+    if (!ID)
+      return nullptr;
+    // Layouts refer to the definitions of their bases.
+    return cast<CXXRecordDecl>(GetDecl(ID))->getDefinition();
+  };
+
+  CharUnits Size = ReadCharUnits();
+  CharUnits DataSize = ReadCharUnits();
+  CharUnits Alignment = ReadCharUnits();
+  CharUnits RequiredAlignment = ReadCharUnits();
+  unsigned NumFields = Data[Idx++];
+  ArrayRef<uint64_t> FieldOffsets(Data + Idx, NumFields);
+  Idx += NumFields;
+
+  ++NumRecordLayoutsRead;
+  if (!Data[Idx++])
+    return new (Context) ASTRecordLayout(Context, Size, Alignment,
+                                          RequiredAlignment, DataSize,
+                                          FieldOffsets);
+
+  CharUnits NonVirtualSize = ReadCharUnits();
+  CharUnits NonVirtualAlignment = ReadCharUnits();
+  CharUnits SizeOfLargestEmptySubobject = ReadCharUnits();
+  CharUnits VBPtrOffset = ReadCharUnits();
+  bool HasOwnVFPtr = Data[Idx++];
+  bool HasExtendableVFPtr = Data[Idx++];
+  bool EndsWithZeroSizedObject = Data[Idx++];
+  bool LeadsWithZeroSizedBase = Data[Idx++];
+  bool IsPrimaryBaseVirtual = Data[Idx++];
+  const CXXRecordDecl *PrimaryBase = ReadRecord();
+  const CXXRecordDecl *BaseSharingVBPtr = ReadRecord();
+
+  ASTRecordLayout::BaseOffsetsMapTy BaseOffsets;
+  for (unsigned I = 0, N = Data[Idx++]; I != N; ++I) {
+    const CXXRecordDecl *Base = ReadRecord();
+    BaseOffsets[Base] = ReadCharUnits();
+  }
+  ASTRecordLayout::VBaseOffsetsMapTy VBaseOffsets;
+  for (unsigned I = 0, N = Data[Idx++]; I != N; ++I) {
+    const CXXRecordDecl *VBase = ReadRecord();
+    CharUnits Offset = ReadCharUnits();
+    VBaseOffsets[VBase] = ASTRecordLayout::VBaseInfo(Offset, Data[Idx++]);
+  }
+
+  return new (Context) ASTRecordLayout(
+      Context, Size, Alignment, RequiredAlignment, HasOwnVFPtr,
+      HasExtendableVFPtr, VBPtrOffset, DataSize, FieldOffsets, NonVirtualSize,
+      NonVirtualAlignment, SizeOfLargestEmptySubobject, PrimaryBase,
+      IsPrimaryBaseVirtual, BaseSharingVBPtr, EndsWithZeroSizedObject,
+      LeadsWithZeroSizedBase, BaseOffsets, VBaseOffsets);
+}
+
 ModuleFile *ASTReader::getOwningModuleFile(const Decl *D) {
   if (!D->isFromASTFile())
     return nullptr;
@@ -6815,9 +6937,21 @@ ASTReader::FindExternalVisibleDeclsByName(const DeclContext *DC,
 
   Deserializing LookupResults(this);
 
+  // If there is a global index, use it to skip the lookup tables of module
+  // files that provably know nothing about this name.
+  reader::ASTDeclContextNameLookupTrait::data_type Found;
+  if (!loadGlobalIndex()) {
+    unsigned Hash = DeclarationNameKey(Name).getHash();
+    Found = It->second.Table.find(Name, [&](ModuleFile *F) {
+      return GlobalIndex->mayContainName(F, Hash);
+    });
+  } else {
+    Found = It->second.Table.find(Name);
+  }
+
   // Load the list of declarations.
   SmallVector<NamedDecl *, 64> Decls;
-  for (DeclID ID : It->second.Table.find(Name)) {
+  for (DeclID ID : Found) {
     NamedDecl *ND = cast<NamedDecl>(GetDecl(ID));
     if (ND->getDeclName() == Name)
       Decls.push_back(ND);
@@ -6977,6 +7111,22 @@ void ASTReader::PrintStats() {
                  NumVisibleDeclContextsRead, TotalVisibleDeclContexts,
                  ((float)NumVisibleDeclContextsRead/TotalVisibleDeclContexts
                   * 100));
+  if (TotalRecordLayouts)
+    std::fprintf(stderr, "  %u/%u record layouts read (%f%%)\n",
+                 NumRecordLayoutsRead, TotalRecordLayouts,
+                 ((float)NumRecordLayoutsRead/TotalRecordLayouts * 100));
+  unsigned NumFilteredLookupProbes = 0;
+  for (auto &Lookup : Lookups)
+    NumFilteredLookupProbes += Lookup.second.Table.getNumFilteredProbes();
+  if (NumFilteredLookupProbes)
+    std::fprintf(stderr,
+                 "  %u declcontext lookup table probes skipped by filters\n",
+                 NumFilteredLookupProbes);
+  ModuleBufferCache &BufferCache = ModuleBufferCache::getGlobal();
+  if (BufferCache.getNumHits())
+    std::fprintf(stderr, "  %u/%u AST file loads shared an existing buffer\n",
+                 BufferCache.getNumHits(),
+                 BufferCache.getNumHits() + BufferCache.getNumMisses());
   if (TotalNumMethodPoolEntries) {
     std::fprintf(stderr, "  %u/%u method pool entries read (%f%%)\n",
                  NumMethodPoolEntriesRead, TotalNumMethodPoolEntries,
@@ -7359,10 +7509,19 @@ void ASTReader::ReadMethodPool(Selector Sel) {
   Generation = getGeneration();
   SelectorOutOfDate[Sel] = false;
   
+  // If there is a global index, look there first to determine which modules
+  // provably do not have any methods with this selector.
+  GlobalModuleIndex::HitSet Hits;
+  GlobalModuleIndex::HitSet *HitsPtr = nullptr;
+  if (!loadGlobalIndex()) {
+    if (GlobalIndex->lookupName(DeclarationNameKey(Sel).getHash(), Hits))
+      HitsPtr = &Hits;
+  }
+
   // Search for methods defined with this selector.
   ++NumMethodPoolLookups;
   ReadMethodPoolVisitor Visitor(*this, Sel, PriorGeneration);
-  ModuleMgr.visit(Visitor);
+  ModuleMgr.visit(Visitor, HitsPtr);
 
   if (Visitor.getInstanceMethods().empty() &&
       Visitor.getFactoryMethods().empty())
@@ -8898,6 +9057,7 @@ ASTReader::ASTReader(
       NumMethodPoolTableHits(0), TotalNumMethodPoolEntries(0),
       NumLexicalDeclContextsRead(0), TotalLexicalDeclContexts(0),
       NumVisibleDeclContextsRead(0), TotalVisibleDeclContexts(0),
+      NumRecordLayoutsRead(0), TotalRecordLayouts(0),
       TotalModulesSizeInBits(0), NumCurrentElementsDeserializing(0),
       PassingDeclsToConsumer(false), ReadingKind(Read_None) {
   SourceMgr.setExternalSLocEntrySource(this);
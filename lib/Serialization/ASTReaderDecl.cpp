@@ -3249,6 +3249,7 @@ Decl *ASTReader::ReadDeclRecord(DeclID ID) {
   Decl *D = nullptr;
   switch ((DeclCode)DeclsCursor.readRecord(Code, Record)) {
   case DECL_CONTEXT_LEXICAL:
+  case DECL_CONTEXT_LEXICAL_COMPRESSED:
   case DECL_CONTEXT_VISIBLE:
     llvm_unreachable("Record cannot be de-serialized with ReadDeclRecord");
   case DECL_TYPEDEF:
@@ -3564,9 +3565,10 @@ void ASTReader::loadDeclUpdateRecords(serialization::DeclID ID, Decl *D) {
 
     auto *DC = cast<DeclContext>(D)->getPrimaryContext();
     for (const PendingVisibleUpdate &Update : VisibleUpdates)
-      Lookups[DC].Table.add(
-          Update.Mod, Update.Data,
-          reader::ASTDeclContextNameLookupTrait(*this, *Update.Mod));
+      if (!Lookups[DC].Table.add(
+              Update.Mod, Update.Data, Update.Size,
+              reader::ASTDeclContextNameLookupTrait(*this, *Update.Mod)))
+        Error("malformed visible lookup table in AST file");
     DC->setHasExternalVisibleStorage(true);
   }
 }
@@ -15,6 +15,7 @@
 #include "ASTCommon.h"
 #include "ASTReaderInternals.h"
 #include "MultiOnDiskHashTable.h"
+#include "OnDiskBloomFilter.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTUnresolvedSet.h"
 #include "clang/AST/Decl.h"
@@ -27,6 +28,7 @@
 #include "clang/AST/LambdaCapture.h"
 #include "clang/AST/NestedNameSpecifier.h"
 #include "clang/AST/RawCommentList.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/TemplateName.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
@@ -1026,6 +1028,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DECL_OFFSET);
   RECORD(IDENTIFIER_OFFSET);
   RECORD(IDENTIFIER_TABLE);
+  RECORD(IDENTIFIER_TABLE_COMPRESSED);
   RECORD(EAGERLY_DESERIALIZED_DECLS);
   RECORD(SPECIAL_TYPES);
   RECORD(STATISTICS);
@@ -1067,6 +1070,8 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(OPTIMIZE_PRAGMA_OPTIONS);
   RECORD(MSSTRUCT_PRAGMA_OPTIONS);
   RECORD(POINTERS_TO_MEMBERS_PRAGMA_OPTIONS);
+  RECORD(LOOKUP_NAME_FILTER);
+  RECORD(RECORD_LAYOUTS);
   RECORD(UNUSED_LOCAL_TYPEDEF_NAME_CANDIDATES);
   RECORD(DELETE_EXPRS_TO_ANALYZE);
 
@@ -1180,6 +1185,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DECL_FILE_SCOPE_ASM);
   RECORD(DECL_BLOCK);
   RECORD(DECL_CONTEXT_LEXICAL);
+  RECORD(DECL_CONTEXT_LEXICAL_COMPRESSED);
   RECORD(DECL_CONTEXT_VISIBLE);
   RECORD(DECL_NAMESPACE);
   RECORD(DECL_NAMESPACE_ALIAS);
@@ -2855,6 +2861,26 @@ void ASTWriter::WriteType(QualType T) {
   }
 }
 
+/// \brief The smallest blob we consider compressing; below this, the zlib
+/// framing and the cost of decompression outweigh the savings.
+static const size_t MinCompressedBlobSize = 1024;
+
+/// \brief Compress the given blob, if blob compression was requested and the
+/// blob is large enough to benefit from it.
+///
+/// \returns true if \p Compressed now holds a smaller, compressed form of
+/// \p Blob, false if the blob should be written uncompressed.
+bool ASTWriter::compressBlob(StringRef Blob,
+                             SmallVectorImpl<char> &Compressed) {
+  if (!CompressBlobs || Blob.size() < MinCompressedBlobSize)
+    return false;
+
+  if (llvm::zlib::compress(Blob, Compressed) != llvm::zlib::StatusOK)
+    return false;
+
+  return Compressed.size() < Blob.size();
+}
+
 //===----------------------------------------------------------------------===//
 // Declaration Serialization
 //===----------------------------------------------------------------------===//
@@ -2877,6 +2903,15 @@ uint64_t ASTWriter::WriteDeclContextLexicalBlock(ASTContext &Context,
   }
 
   ++NumLexicalDeclContexts;
+  SmallString<0> Compressed;
+  if (compressBlob(bytes(KindDeclPairs), Compressed)) {
+    RecordData::value_type Record[] = {DECL_CONTEXT_LEXICAL_COMPRESSED,
+                                       KindDeclPairs.size() * 4};
+    Stream.EmitRecordWithBlob(DeclContextLexicalCompressedAbbrev, Record,
+                              Compressed);
+    return Offset;
+  }
+
   RecordData::value_type Record[] = {DECL_CONTEXT_LEXICAL};
   Stream.EmitRecordWithBlob(DeclContextLexicalAbbrev, Record,
                             bytes(KindDeclPairs));
@@ -3122,6 +3157,7 @@ void ASTWriter::WriteSelectors(Sema &SemaRef) {
         // A new method pool entry.
         ++NumTableEntries;
       }
+      AddLookupNameHash(DeclarationNameKey(S).getHash());
       Generator.insert(S, Data, Trait);
     }
 
@@ -3447,16 +3483,31 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
       BucketOffset = Generator.Emit(Out, Trait);
     }
 
-    // Create a blob abbreviation
-    auto *Abbrev = new BitCodeAbbrev();
-    Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE));
-    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
-    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
-    unsigned IDTableAbbrev = Stream.EmitAbbrev(Abbrev);
-
-    // Write the identifier table
-    RecordData::value_type Record[] = {IDENTIFIER_TABLE, BucketOffset};
-    Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
+    // Write the identifier table, compressed if requested.
+    SmallString<0> Compressed;
+    if (compressBlob(IdentifierTable, Compressed)) {
+      auto *Abbrev = new BitCodeAbbrev();
+      Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE_COMPRESSED));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+      unsigned IDTableAbbrev = Stream.EmitAbbrev(Abbrev);
+
+      RecordData::value_type Record[] = {IDENTIFIER_TABLE_COMPRESSED,
+                                         BucketOffset, IdentifierTable.size()};
+      Stream.EmitRecordWithBlob(IDTableAbbrev, Record, Compressed);
+    } else {
+      // Create a blob abbreviation
+      auto *Abbrev = new BitCodeAbbrev();
+      Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+      unsigned IDTableAbbrev = Stream.EmitAbbrev(Abbrev);
+
+      // Write the identifier table
+      RecordData::value_type Record[] = {IDENTIFIER_TABLE, BucketOffset};
+      Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
+    }
   }
 
   // Write the offsets table for identifier IDs.
@@ -3806,6 +3857,16 @@ ASTWriter::GenerateNameLookupTable(const DeclContext *ConstDC,
   // Create the on-disk hash table. Also emit the existing imported and
   // merged table if there is one.
   auto *Lookups = Chain ? Chain->getLoadedLookupTables(DC) : nullptr;
+
+  // Note every name the table will have an entry for, including the entries
+  // of the merged table, for the LOOKUP_NAME_FILTER record.
+  for (auto &Name : Names)
+    AddLookupNameHash(DeclarationNameKey(Name).getHash());
+  if (Lookups)
+    Lookups->Table.forEachMergedKey([&](const DeclarationNameKey &Key) {
+      AddLookupNameHash(Key.getHash());
+    });
+
   Generator.emit(LookupTable, Trait, Lookups ? &Lookups->Table : nullptr);
 }
 
@@ -3924,6 +3985,128 @@ void ASTWriter::WriteDeclContextVisibleUpdate(const DeclContext *DC) {
   Stream.EmitRecordWithBlob(UpdateVisibleAbbrev, Record, LookupTable);
 }
 
+/// \brief Add the given record layout to the record, for
+/// ASTReader::getStoredRecordLayout.
+///
+/// \returns false if the layout refers to a declaration that is not in the
+/// AST file or one of the files it depends on.
+bool ASTWriter::AddRecordLayout(const ASTRecordLayout &Layout,
+                                RecordDataImpl &Record) {
+  auto IsWritten = [&](const CXXRecordDecl *RD) {
+    return !RD || RD->isFromASTFile() || DeclIDs.count(RD);
+  };
+
+  Record.push_back(Layout.getSize().getQuantity());
+  Record.push_back(Layout.getDataSize().getQuantity());
+  Record.push_back(Layout.getAlignment().getQuantity());
+  Record.push_back(Layout.getRequiredAlignment().getQuantity());
+  Record.push_back(Layout.FieldOffsets.size());
+  Record.append(Layout.FieldOffsets.begin(), Layout.FieldOffsets.end());
+
+  const ASTRecordLayout::CXXRecordLayoutInfo *CXXInfo = Layout.CXXInfo;
+  Record.push_back(CXXInfo != nullptr);
+  if (!CXXInfo)
+    return true;
+
+  Record.push_back(CXXInfo->NonVirtualSize.getQuantity());
+  Record.push_back(CXXInfo->NonVirtualAlignment.getQuantity());
+  Record.push_back(CXXInfo->SizeOfLargestEmptySubobject.getQuantity());
+  Record.push_back(CXXInfo->VBPtrOffset.getQuantity());
+  Record.push_back(CXXInfo->HasOwnVFPtr);
+  Record.push_back(CXXInfo->HasExtendableVFPtr);
+  Record.push_back(CXXInfo->EndsWithZeroSizedObject);
+  Record.push_back(CXXInfo->LeadsWithZeroSizedBase);
+  Record.push_back(CXXInfo->PrimaryBase.getInt());
+  if (!IsWritten(CXXInfo->PrimaryBase.getPointer()) ||
+      !IsWritten(CXXInfo->BaseSharingVBPtr))
+    return false;
+  Record.push_back(getDeclID(CXXInfo->PrimaryBase.getPointer()));
+  Record.push_back(getDeclID(CXXInfo->BaseSharingVBPtr));
+
+  // Write the bases in a deterministic order.
+  SmallVector<std::pair<DeclID, const CXXRecordDecl *>, 4> Bases;
+  for (const auto &Base : CXXInfo->BaseOffsets) {
+    if (!IsWritten(Base.first))
+      return false;
+    Bases.push_back(std::make_pair(getDeclID(Base.first), Base.first));
+  }
+  std::sort(Bases.begin(), Bases.end(), llvm::less_first());
+  Record.push_back(Bases.size());
+  for (const auto &Base : Bases) {
+    Record.push_back(Base.first);
+    Record.push_back(CXXInfo->BaseOffsets.lookup(Base.second).getQuantity());
+  }
+
+  SmallVector<std::pair<DeclID, const CXXRecordDecl *>, 4> VBases;
+  for (const auto &VBase : CXXInfo->VBaseOffsets) {
+    if (!IsWritten(VBase.first))
+      return false;
+    VBases.push_back(std::make_pair(getDeclID(VBase.first), VBase.first));
+  }
+  std::sort(VBases.begin(), VBases.end(), llvm::less_first());
+  Record.push_back(VBases.size());
+  for (const auto &VBase : VBases) {
+    ASTRecordLayout::VBaseInfo Info = CXXInfo->VBaseOffsets.lookup(VBase.second);
+    Record.push_back(VBase.first);
+    Record.push_back(Info.VBaseOffset.getQuantity());
+    Record.push_back(Info.hasVtorDisp());
+  }
+  return true;
+}
+
+/// \brief Write the layouts of the record definitions in this AST file that
+/// have been laid out, so that users of the file need not lay them out again.
+void ASTWriter::WriteRecordLayouts(ASTContext &Context) {
+  // Write the layouts in declaration ID order, so that the file does not
+  // depend on the order of the ASTContext's layout cache.
+  SmallVector<std::pair<DeclID, const ASTRecordLayout *>, 64> Layouts;
+  for (const auto &Entry : Context.ASTRecordLayouts) {
+    if (!Entry.second || Entry.first->isFromASTFile())
+      continue;
+    auto ID = DeclIDs.find(Entry.first);
+    if (ID == DeclIDs.end() || ID->second < NUM_PREDEF_DECL_IDS)
+      continue;
+    Layouts.push_back(std::make_pair(ID->second, Entry.second));
+  }
+  std::sort(Layouts.begin(), Layouts.end(), llvm::less_first());
+
+  RecordData Record;
+  RecordData Data;
+  for (const auto &Entry : Layouts) {
+    Data.clear();
+    if (!AddRecordLayout(*Entry.second, Data))
+      continue;
+    Record.push_back(Entry.first);
+    Record.push_back(Data.size());
+    Record.append(Data.begin(), Data.end());
+  }
+  if (!Record.empty())
+    Stream.EmitRecord(RECORD_LAYOUTS, Record);
+}
+
+/// \brief Write the bloom filter summarizing the names that the lookup tables
+/// and method pool of this module file have entries for.
+void ASTWriter::WriteLookupNameFilter() {
+  if (LookupNameHashes.empty())
+    return;
+
+  OnDiskBloomFilterGenerator Filter;
+  for (unsigned Hash : LookupNameHashes)
+    Filter.insert(Hash);
+  LookupNameHashes.clear();
+
+  SmallString<1024> FilterData;
+  Filter.emit(FilterData);
+
+  auto *Abbrev = new BitCodeAbbrev();
+  Abbrev->Add(BitCodeAbbrevOp(LOOKUP_NAME_FILTER));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+  unsigned FilterAbbrev = Stream.EmitAbbrev(Abbrev);
+
+  RecordData::value_type Record[] = {LOOKUP_NAME_FILTER};
+  Stream.EmitRecordWithBlob(FilterAbbrev, Record, FilterData);
+}
+
 /// \brief Write an FP_PRAGMA_OPTIONS block for the given FPOptions.
 void ASTWriter::WriteFPPragmaOptions(const FPOptions &Opts) {
   RecordData::value_type Record[] = {Opts.fp_contract};
@@ -4178,9 +4361,10 @@ void ASTWriter::SetSelectorOffset(Selector Sel, uint32_t Offset) {
 ASTWriter::ASTWriter(
   llvm::BitstreamWriter &Stream,
   ArrayRef<llvm::IntrusiveRefCntPtr<ModuleFileExtension>> Extensions,
-  bool IncludeTimestamps)
+  bool IncludeTimestamps, bool CompressBlobs, bool StoreRecordLayouts)
     : Stream(Stream), Context(nullptr), PP(nullptr), Chain(nullptr),
       WritingModule(nullptr), IncludeTimestamps(IncludeTimestamps),
+      CompressBlobs(CompressBlobs), StoreRecordLayouts(StoreRecordLayouts),
       WritingAST(false), DoneWritingDeclsAndTypes(false),
       ASTHasCompilerErrors(false), FirstDeclID(NUM_PREDEF_DECL_IDS),
       NextDeclID(FirstDeclID), FirstTypeID(NUM_PREDEF_TYPE_IDS),
@@ -4192,7 +4376,8 @@ ASTWriter::ASTWriter(
       NumStatements(0), NumMacros(0),
       NumLexicalDeclContexts(0), NumVisibleDeclContexts(0),
       TypeExtQualAbbrev(0), TypeFunctionProtoAbbrev(0), DeclParmVarAbbrev(0),
-      DeclContextLexicalAbbrev(0), DeclContextVisibleLookupAbbrev(0),
+      DeclContextLexicalAbbrev(0), DeclContextLexicalCompressedAbbrev(0),
+      DeclContextVisibleLookupAbbrev(0),
       UpdateVisibleAbbrev(0), DeclRecordAbbrev(0), DeclTypedefAbbrev(0),
       DeclVarAbbrev(0), DeclFieldAbbrev(0), DeclEnumAbbrev(0),
       DeclObjCIvarAbbrev(0), DeclCXXMethodAbbrev(0), DeclRefExprAbbrev(0),
@@ -4694,6 +4879,9 @@ uint64_t ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
   if (!DeleteExprsToAnalyze.empty())
     Stream.EmitRecord(DELETE_EXPRS_TO_ANALYZE, DeleteExprsToAnalyze);
 
+  if (StoreRecordLayouts)
+    WriteRecordLayouts(Context);
+
   // Write the visible updates to DeclContexts.
   for (auto *DC : UpdatedDeclContexts)
     WriteDeclContextVisibleUpdate(DC);
@@ -4739,6 +4927,8 @@ uint64_t ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
   }
 
   WriteObjCCategories();
+  if (WritingModule)
+    WriteLookupNameFilter();
   if(!WritingModule) {
     WriteOptimizePragmaOptions(SemaRef);
     WriteMSStructPragmaOptions(SemaRef);
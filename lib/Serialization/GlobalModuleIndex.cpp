@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "ASTReaderInternals.h"
+#include "OnDiskBloomFilter.h"
 #include "clang/Frontend/PCHContainerOperations.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Lex/HeaderSearch.h"
@@ -24,6 +25,7 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamReader.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -50,7 +52,10 @@ namespace {
     /// \brief Describes a module, including its file name and dependencies.
     MODULE,
     /// \brief The index for identifiers.
-    IDENTIFIER_INDEX
+    IDENTIFIER_INDEX,
+    /// \brief The bloom filter over the DeclContext lookup and selector names
+    /// known to a module.
+    NAME_FILTER
   };
 }
 
@@ -58,7 +63,7 @@ namespace {
 static const char * const IndexFileName = "modules.idx";
 
 /// \brief The global index file version.
-static const unsigned CurrentVersion = 1;
+static const unsigned CurrentVersion = 2;
 
 //----------------------------------------------------------------------------//
 // Global module index reader.
@@ -126,7 +131,8 @@ typedef llvm::OnDiskIterableChainedHashTable<IdentifierIndexReaderTrait>
 GlobalModuleIndex::GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
                                      llvm::BitstreamCursor Cursor)
     : Buffer(std::move(Buffer)), IdentifierIndex(), NumIdentifierLookups(),
-      NumIdentifierLookupHits() {
+      NumIdentifierLookupHits(), NumNameFilterChecks(),
+      NumNameFilterRejections() {
   // Read the global index.
   bool InGlobalIndexBlock = false;
   bool Done = false;
@@ -224,6 +230,14 @@ GlobalModuleIndex::GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
             (const unsigned char *)Blob.data(), IdentifierIndexReaderTrait());
       }
       break;
+
+    case NAME_FILTER: {
+      // The filter is stored after the module it describes.
+      unsigned ID = Record[0];
+      if (ID < Modules.size())
+        Modules[ID].NameFilter = Blob;
+      break;
+    }
     }
   }
 }
@@ -317,6 +331,40 @@ bool GlobalModuleIndex::lookupIdentifier(StringRef Name, HitSet &Hits) {
   return true;
 }
 
+bool GlobalModuleIndex::moduleMayContainName(unsigned ID, unsigned NameHash) {
+  StringRef Filter = Modules[ID].NameFilter;
+  if (Filter.empty())
+    return true;
+
+  ++NumNameFilterChecks;
+  if (serialization::OnDiskBloomFilter(Filter).mayContain(NameHash))
+    return true;
+
+  ++NumNameFilterRejections;
+  return false;
+}
+
+bool GlobalModuleIndex::lookupName(unsigned NameHash, HitSet &Hits) {
+  Hits.clear();
+
+  for (unsigned ID = 0, N = Modules.size(); ID != N; ++ID) {
+    if (ModuleFile *MF = Modules[ID].File)
+      if (moduleMayContainName(ID, NameHash))
+        Hits.insert(MF);
+  }
+
+  return true;
+}
+
+bool GlobalModuleIndex::mayContainName(ModuleFile *File, unsigned NameHash) {
+  llvm::DenseMap<ModuleFile *, unsigned>::iterator Known
+    = ModulesByFile.find(File);
+  if (Known == ModulesByFile.end())
+    return true;
+
+  return moduleMayContainName(Known->second, NameHash);
+}
+
 bool GlobalModuleIndex::loadedModuleFile(ModuleFile *File) {
   // Look for the module in the global module index based on the module name.
   StringRef Name = File->ModuleName;
@@ -351,6 +399,11 @@ void GlobalModuleIndex::printStats() {
             NumIdentifierLookupHits, NumIdentifierLookups,
             (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
   }
+  if (NumNameFilterChecks) {
+    fprintf(stderr, "  %u / %u name filter checks ruled out a module (%f%%)\n",
+            NumNameFilterRejections, NumNameFilterChecks,
+            (double)NumNameFilterRejections*100.0/NumNameFilterChecks);
+  }
   std::fprintf(stderr, "\n");
 }
 
@@ -380,6 +433,9 @@ namespace {
     /// \brief The set of modules on which this module depends. Each entry is
     /// a module ID.
     SmallVector<unsigned, 4> Dependencies;
+
+    /// \brief The module file's LOOKUP_NAME_FILTER blob, if it has one.
+    std::string NameFilter;
   };
 
   /// \brief Builder that generates the global module index file.
@@ -468,6 +524,7 @@ GlobalModuleIndexBuilder::emitBlockInfoBlock(llvm::BitstreamWriter &Stream) {
   RECORD(INDEX_METADATA);
   RECORD(MODULE);
   RECORD(IDENTIFIER_INDEX);
+  RECORD(NAME_FILTER);
 #undef RECORD
 #undef BLOCK
 
@@ -618,7 +675,17 @@ bool GlobalModuleIndexBuilder::loadModuleFile(const FileEntry *File) {
       continue;
     }
 
-    // Handle the identifier table
+    // Handle the identifier table, which may have been compressed.
+    SmallString<0> Uncompressed;
+    if (State == ASTBlock && Code == IDENTIFIER_TABLE_COMPRESSED &&
+        Record[0] > 0) {
+      if (llvm::zlib::uncompress(Blob, Uncompressed, Record[1]) !=
+          llvm::zlib::StatusOK)
+        return true;
+      Blob = Uncompressed;
+      Code = IDENTIFIER_TABLE;
+    }
+
     if (State == ASTBlock && Code == IDENTIFIER_TABLE && Record[0] > 0) {
       typedef llvm::OnDiskIterableChainedHashTable<
           InterestingASTIdentifierLookupTrait> InterestingIdentifierTable;
@@ -638,6 +705,12 @@ bool GlobalModuleIndexBuilder::loadModuleFile(const FileEntry *File) {
       }
     }
 
+    // Handle the name filter, which we copy into the index verbatim.
+    if (State == ASTBlock && Code == LOOKUP_NAME_FILTER) {
+      getModuleFileInfo(File).NameFilter = Blob;
+      continue;
+    }
+
     // We don't care about this record.
   }
 
@@ -726,6 +799,23 @@ void GlobalModuleIndexBuilder::writeIndex(llvm::BitstreamWriter &Stream) {
     Stream.EmitRecord(MODULE, Record);
   }
 
+  // Write the name filters of the module files that provided one.
+  {
+    BitCodeAbbrev *Abbrev = new BitCodeAbbrev();
+    Abbrev->Add(BitCodeAbbrevOp(NAME_FILTER));
+    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6));
+    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+    unsigned NameFilterAbbrev = Stream.EmitAbbrev(Abbrev);
+
+    for (auto &M : ModuleFiles) {
+      if (M.second.NameFilter.empty())
+        continue;
+
+      uint64_t Record[] = {NAME_FILTER, M.second.ID};
+      Stream.EmitRecordWithBlob(NameFilterAbbrev, Record, M.second.NameFilter);
+    }
+  }
+
   // Write the identifier -> module file mapping.
   {
     llvm::OnDiskChainedHashTableGenerator<IdentifierIndexWriterTrait> Generator;
@@ -0,0 +1,64 @@
+//===--- ModuleBufferCache.cpp - Process-wide AST file buffers --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the ModuleBufferCache class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Serialization/ModuleBufferCache.h"
+#include "clang/Basic/FileManager.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace clang;
+using namespace serialization;
+
+ModuleBufferCache &ModuleBufferCache::getGlobal() {
+  static ModuleBufferCache Cache;
+  return Cache;
+}
+
+ModuleBufferCache::KeyType ModuleBufferCache::getKey(const FileEntry *File) {
+  return KeyType(File->getUniqueID(), File->getSize(),
+                 File->getModificationTime());
+}
+
+std::shared_ptr<llvm::MemoryBuffer>
+ModuleBufferCache::lookup(const FileEntry *File) {
+  llvm::sys::SmartScopedLock<true> Guard(Lock);
+  auto Known = Buffers.find(getKey(File));
+  if (Known == Buffers.end())
+    return nullptr;
+
+  std::shared_ptr<llvm::MemoryBuffer> Buffer = Known->second.lock();
+  if (!Buffer) {
+    // Everyone who was using this buffer is gone.
+    Buffers.erase(Known);
+    return nullptr;
+  }
+
+  ++NumHits;
+  return Buffer;
+}
+
+std::shared_ptr<llvm::MemoryBuffer>
+ModuleBufferCache::insert(const FileEntry *File,
+                          std::unique_ptr<llvm::MemoryBuffer> Buffer) {
+  llvm::sys::SmartScopedLock<true> Guard(Lock);
+  std::weak_ptr<llvm::MemoryBuffer> &Entry = Buffers[getKey(File)];
+  if (std::shared_ptr<llvm::MemoryBuffer> Existing = Entry.lock()) {
+    // We lost a race with another thread loading the same file.
+    ++NumHits;
+    return Existing;
+  }
+
+  ++NumMisses;
+  std::shared_ptr<llvm::MemoryBuffer> Shared(std::move(Buffer));
+  Entry = Shared;
+  return Shared;
+}
@@ -16,6 +16,7 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/ModuleMap.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
+#include "clang/Serialization/ModuleBufferCache.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include <system_error>
@@ -105,10 +106,16 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
             Status.getLastModificationTime().toEpochTime();
     }
 
-    // Load the contents of the module
+    // Load the contents of the module. Files with a real on-disk identity
+    // are shared with every other module manager in the process.
+    ModuleBufferCache &BufferCache = ModuleBufferCache::getGlobal();
+    bool ShareBuffer = FileName != "-" && Entry->isValid();
     if (std::unique_ptr<llvm::MemoryBuffer> Buffer = lookupBuffer(FileName)) {
       // The buffer was already provided for us.
       ModuleEntry->Buffer = std::move(Buffer);
+    } else if (ShareBuffer && (ModuleEntry->Buffer =
+                                   BufferCache.lookup(ModuleEntry->File))) {
+      // Another module manager in this process has this file loaded.
     } else {
       // Open the AST file.
       llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buf(
@@ -131,7 +138,11 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
         return Missing;
       }
 
-      ModuleEntry->Buffer = std::move(*Buf);
+      if (ShareBuffer)
+        ModuleEntry->Buffer =
+            BufferCache.insert(ModuleEntry->File, std::move(*Buf));
+      else
+        ModuleEntry->Buffer = std::move(*Buf);
     }
 
     // Initialize the stream.
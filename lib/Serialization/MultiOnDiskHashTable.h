@@ -12,12 +12,14 @@
 //
 //  Multiple hash tables from different files are implicitly merged to improve
 //  performance, and on reload the merged table will override those from other
-//  files.
+//  files. Each on-disk table carries a bloom filter over its keys, so that
+//  lookups of keys a table does not contain rarely need to touch it.
 //
 //===----------------------------------------------------------------------===//
 #ifndef LLVM_CLANG_LIB_SERIALIZATION_MULTIONDISKHASHTABLE_H
 #define LLVM_CLANG_LIB_SERIALIZATION_MULTIONDISKHASHTABLE_H
 
+#include "OnDiskBloomFilter.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/PointerUnion.h"
@@ -52,12 +54,14 @@ private:
 
     file_type File;
     HashTable Table;
+    OnDiskBloomFilter Filter;
 
     OnDiskTable(file_type File, unsigned NumBuckets, unsigned NumEntries,
                 storage_type Buckets, storage_type Payload, storage_type Base,
-                const Info &InfoObj)
+                OnDiskBloomFilter Filter, const Info &InfoObj)
         : File(File),
-          Table(NumBuckets, NumEntries, Buckets, Payload, Base, InfoObj) {}
+          Table(NumBuckets, NumEntries, Buckets, Payload, Base, InfoObj),
+          Filter(Filter) {}
   };
 
   struct MergedTable {
@@ -79,6 +83,10 @@ private:
   /// discarded.
   llvm::TinyPtrVector<file_type> PendingOverrides;
 
+  /// \brief The number of on-disk table probes skipped because the table's
+  /// bloom filter ruled out the key.
+  unsigned NumFilteredProbes = 0;
+
   struct AsOnDiskTable {
     typedef OnDiskTable *result_type;
     result_type operator()(void *P) const {
@@ -168,7 +176,8 @@ public:
   MultiOnDiskHashTable() {}
   MultiOnDiskHashTable(MultiOnDiskHashTable &&O)
       : Tables(std::move(O.Tables)),
-        PendingOverrides(std::move(O.PendingOverrides)) {
+        PendingOverrides(std::move(O.PendingOverrides)),
+        NumFilteredProbes(O.NumFilteredProbes) {
     O.Tables.clear();
   }
   MultiOnDiskHashTable &operator=(MultiOnDiskHashTable &&O) {
@@ -178,16 +187,36 @@ public:
     Tables = std::move(O.Tables);
     O.Tables.clear();
     PendingOverrides = std::move(O.PendingOverrides);
+    NumFilteredProbes = O.NumFilteredProbes;
     return *this;
   }
   ~MultiOnDiskHashTable() { clear(); }
 
-  /// \brief Add the table \p Data loaded from file \p File.
-  void add(file_type File, storage_type Data, Info InfoObj = Info()) {
+  /// \brief Add the table \p Data of \p Size bytes loaded from file \p File.
+  ///
+  /// \returns false, without adding anything, if the table's header does not
+  /// fit within \p Size bytes.
+  bool add(file_type File, storage_type Data, size_t Size,
+           Info InfoObj = Info()) {
     using namespace llvm::support;
     storage_type Ptr = Data;
 
+    if (Size < 12)
+      return false;
     uint32_t BucketOffset = endian::readNext<uint32_t, little, unaligned>(Ptr);
+    uint32_t FilterOffset = endian::readNext<uint32_t, little, unaligned>(Ptr);
+    if (BucketOffset >= Size || FilterOffset >= Size)
+      return false;
+
+    // The bloom filter, if any, runs from its offset to the end of the table.
+    // A filter that does not fit there means the table is malformed.
+    OnDiskBloomFilter Filter;
+    if (FilterOffset) {
+      Filter = OnDiskBloomFilter(llvm::StringRef(
+          (const char *)Data + FilterOffset, Size - FilterOffset));
+      if (!Filter.isValid())
+        return false;
+    }
 
     // Read the list of overridden files.
     uint32_t NumFiles = endian::readNext<uint32_t, little, unaligned>(Ptr);
@@ -208,12 +237,23 @@ public:
     // Register the table.
     Table NewTable = new OnDiskTable(File, NumBucketsAndEntries.first,
                                      NumBucketsAndEntries.second,
-                                     Buckets, Ptr, Data, std::move(InfoObj));
+                                     Buckets, Ptr, Data, Filter,
+                                     std::move(InfoObj));
     Tables.push_back(NewTable.getOpaqueValue());
+    return true;
   }
 
   /// \brief Find and read the lookup results for \p EKey.
   data_type find(const external_key_type &EKey) {
+    return find(EKey, [](file_type) { return true; });
+  }
+
+  /// \brief Find and read the lookup results for \p EKey, only consulting
+  /// the on-disk tables from files for which \p ShouldSearch returns true.
+  ///
+  /// Tables that have already been merged are always searched.
+  template <typename FilePredicate>
+  data_type find(const external_key_type &EKey, FilePredicate ShouldSearch) {
     data_type Result;
 
     if (!PendingOverrides.empty())
@@ -234,6 +274,14 @@ public:
     data_type_builder ResultBuilder(Result);
 
     for (auto *ODT : tables()) {
+      if (!ShouldSearch(ODT->File))
+        continue;
+
+      if (!ODT->Filter.mayContain(KeyHash)) {
+        ++NumFilteredProbes;
+        continue;
+      }
+
       auto &HT = ODT->Table;
       auto It = HT.find_hashed(Key, KeyHash);
       if (It != HT.end())
@@ -273,6 +321,18 @@ public:
 
     return Result;
   }
+
+  /// \brief The number of on-disk table probes that were avoided because a
+  /// table's bloom filter proved that it did not contain the key.
+  unsigned getNumFilteredProbes() const { return NumFilteredProbes; }
+
+  /// \brief Call \p F with each key of the in-memory table that condensed
+  /// tables were merged into, if there is one.
+  template <typename Fn> void forEachMergedKey(Fn F) const {
+    if (MergedTable *M = getMergedTable())
+      for (auto &KV : M->Data)
+        F(KV.first);
+  }
 };
 
 /// \brief Writer for the on-disk hash table.
@@ -282,12 +342,14 @@ class MultiOnDiskHashTableGenerator {
   typedef llvm::OnDiskChainedHashTableGenerator<WriterInfo> Generator;
 
   Generator Gen;
+  OnDiskBloomFilterGenerator Filter;
 
 public:
   MultiOnDiskHashTableGenerator() : Gen() {}
 
   void insert(typename WriterInfo::key_type_ref Key,
               typename WriterInfo::data_type_ref Data, WriterInfo &Info) {
+    Filter.insert(Info.ComputeHash(Key));
     Gen.insert(Key, Data, Info);
   }
 
@@ -300,7 +362,8 @@ public:
     {
       endian::Writer<little> Writer(OutStream);
 
-      // Reserve four bytes for the bucket offset.
+      // Reserve four bytes each for the bucket and filter offsets.
+      Writer.write<uint32_t>(0);
       Writer.write<uint32_t>(0);
 
       if (auto *Merged = Base ? Base->getMergedTable() : nullptr) {
@@ -312,7 +375,7 @@ public:
         // Add all merged entries from Base to the generator.
         for (auto &KV : Merged->Data) {
           if (!Gen.contains(KV.first, Info))
-            Gen.insert(KV.first, Info.ImportData(KV.second), Info);
+            insert(KV.first, Info.ImportData(KV.second), Info);
         }
       } else {
         Writer.write<uint32_t>(0);
@@ -322,8 +385,13 @@ public:
     // Write the table itself.
     uint32_t BucketOffset = Gen.Emit(OutStream, Info);
 
-    // Replace the first four bytes with the bucket offset.
+    // Write the bloom filter over the keys after the table.
+    uint32_t FilterOffset = Out.size();
+    Filter.emit(OutStream);
+
+    // Fill in the bucket and filter offsets.
     endian::write32le(Out.data(), BucketOffset);
+    endian::write32le(Out.data() + 4, FilterOffset);
   }
 };
 
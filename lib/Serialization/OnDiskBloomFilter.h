@@ -0,0 +1,152 @@
+//===--- OnDiskBloomFilter.h - Bloom filter stored in AST files -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file provides a compact bloom filter over 32-bit hash values that can
+//  be serialized into a blob and queried in place, without deserialization.
+//  It is used to rule out AST files (or tables within them) that provably do
+//  not know about a given name.
+//
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_CLANG_LIB_SERIALIZATION_ONDISKBLOOMFILTER_H
+#define LLVM_CLANG_LIB_SERIALIZATION_ONDISKBLOOMFILTER_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+namespace clang {
+namespace serialization {
+
+/// \brief Shared parameters of the on-disk bloom filter format.
+///
+/// The on-disk representation is a little-endian 32-bit bit count (always a
+/// power of two), a little-endian 32-bit probe count, followed by the bit
+/// array itself, addressed byte by byte.
+struct OnDiskBloomFilterBase {
+  /// \brief The number of bits we allocate per distinct hash value.
+  static const unsigned BitsPerEntry = 10;
+
+  /// \brief The number of bits set for each hash value.
+  static const unsigned NumProbes = 4;
+
+  /// \brief The smallest filter we will emit, in bits.
+  static const unsigned MinBits = 64;
+
+  /// \brief The size of the header preceding the bit array, in bytes.
+  static const unsigned HeaderSize = 8;
+
+  /// \brief Compute the bit index for the given probe of the given hash.
+  ///
+  /// Uses double hashing, deriving the second hash by mixing the first so
+  /// that only a single 32-bit hash needs to be stored or computed.
+  static uint32_t getProbe(uint32_t Hash, unsigned Probe, uint32_t NumBits) {
+    uint32_t Step = ((Hash >> 16) | (Hash << 16)) * 0x85ebca6bU;
+    return (Hash + Probe * (Step | 1)) & (NumBits - 1);
+  }
+};
+
+/// \brief Builds an on-disk bloom filter from a set of 32-bit hash values.
+class OnDiskBloomFilterGenerator : public OnDiskBloomFilterBase {
+  llvm::SmallVector<uint32_t, 64> Hashes;
+
+public:
+  /// \brief Add the given hash value to the filter.
+  void insert(uint32_t Hash) { Hashes.push_back(Hash); }
+
+  /// \brief Whether no hash values have been added to the filter.
+  bool empty() const { return Hashes.empty(); }
+
+  /// \brief Emit the filter, sized for the number of distinct hash values
+  /// added so far.
+  void emit(llvm::raw_ostream &Out) {
+    std::sort(Hashes.begin(), Hashes.end());
+    Hashes.erase(std::unique(Hashes.begin(), Hashes.end()), Hashes.end());
+
+    uint64_t WantedBits = uint64_t(Hashes.size()) * BitsPerEntry;
+    uint32_t NumBits = MinBits;
+    while (NumBits < WantedBits && NumBits < (1U << 31))
+      NumBits <<= 1;
+
+    llvm::SmallVector<unsigned char, 128> Bits(NumBits / 8);
+    for (uint32_t Hash : Hashes) {
+      for (unsigned I = 0; I != NumProbes; ++I) {
+        uint32_t Bit = getProbe(Hash, I, NumBits);
+        Bits[Bit / 8] |= 1 << (Bit % 8);
+      }
+    }
+
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    LE.write<uint32_t>(NumBits);
+    LE.write<uint32_t>(NumProbes);
+    Out.write((const char *)Bits.data(), Bits.size());
+  }
+
+  /// \brief Emit the filter into the given buffer.
+  void emit(llvm::SmallVectorImpl<char> &Out) {
+    llvm::raw_svector_ostream OutStream(Out);
+    emit(OutStream);
+  }
+};
+
+/// \brief A read-only view of a bloom filter emitted by
+/// \c OnDiskBloomFilterGenerator.
+///
+/// A default-constructed (or malformed) filter conservatively claims to
+/// contain every hash value.
+class OnDiskBloomFilter : public OnDiskBloomFilterBase {
+  const unsigned char *Bits;
+  uint32_t NumBits;
+  uint32_t NumFilterProbes;
+
+public:
+  OnDiskBloomFilter() : Bits(nullptr), NumBits(0), NumFilterProbes(0) {}
+
+  explicit OnDiskBloomFilter(llvm::StringRef Blob) : OnDiskBloomFilter() {
+    if (Blob.size() < HeaderSize)
+      return;
+
+    using namespace llvm::support;
+    const unsigned char *Ptr = (const unsigned char *)Blob.data();
+    uint32_t StoredBits = endian::readNext<uint32_t, little, unaligned>(Ptr);
+    uint32_t StoredProbes = endian::readNext<uint32_t, little, unaligned>(Ptr);
+    if (!llvm::isPowerOf2_32(StoredBits) || StoredBits % 8 != 0 ||
+        Blob.size() - HeaderSize < StoredBits / 8)
+      return;
+
+    Bits = Ptr;
+    NumBits = StoredBits;
+    NumFilterProbes = StoredProbes;
+  }
+
+  /// \brief Whether this filter carries any information at all.
+  bool isValid() const { return Bits != nullptr; }
+
+  /// \brief Determine whether the given hash value may have been added to the
+  /// filter. A false result is definitive.
+  bool mayContain(uint32_t Hash) const {
+    if (!Bits)
+      return true;
+
+    for (unsigned I = 0; I != NumFilterProbes; ++I) {
+      uint32_t Bit = getProbe(Hash, I, NumBits);
+      if (!(Bits[Bit / 8] & (1 << (Bit % 8))))
+        return false;
+    }
+    return true;
+  }
+};
+
+} // end namespace clang::serialization
+} // end namespace clang
+
+#endif
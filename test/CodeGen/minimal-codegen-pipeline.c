@@ -0,0 +1,49 @@
+// REQUIRES: x86-registered-target
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=MINIMAL
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -DALWAYS_INLINE \
+// RUN:   -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -O1 -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+
+// Instrumentation needs the IR pass pipeline.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -fsanitize=address \
+// RUN:   -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -fsanitize-coverage-type=1 \
+// RUN:   -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -o %t.o %s \
+// RUN:   -fminimal-codegen-pipeline -fprofile-instrument=clang \
+// RUN:   -mllvm -debug-pass=Structure 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FULL
+
+// RUN: %clang -target x86_64-unknown-linux-gnu -fminimal-codegen-pipeline \
+// RUN:   -### -c %s 2>&1 | FileCheck %s --check-prefix=DRIVER
+
+#ifdef ALWAYS_INLINE
+__attribute__((always_inline))
+#endif
+static inline int twice(int x) { return x * 2; }
+
+int f(int x) { return twice(x) + 1; }
+
+// Only the code generator's pass manager is set up, and the module is
+// verified once.
+// MINIMAL-NOT: Inliner for always_inline functions
+// MINIMAL: Module Verifier
+// MINIMAL-NOT: Module Verifier
+// MINIMAL: X86 Assembly Printer
+
+// FULL: Inliner for always_inline functions
+
+// DRIVER: "-fminimal-codegen-pipeline"
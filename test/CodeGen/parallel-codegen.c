@@ -0,0 +1,28 @@
+// REQUIRES: x86-registered-target
+// RUN: rm -f %t.o %t.1.o
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj \
+// RUN:   -fparallel-codegen=2 %s -o %t.o
+// RUN: llvm-nm %t.o %t.1.o | FileCheck %s
+// The partitions are named after the output, keeping its extension.
+// RUN: rm -f %t.obj %t.1.obj
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj \
+// RUN:   -fparallel-codegen=2 %s -o %t.obj
+// RUN: llvm-nm %t.obj %t.1.obj | FileCheck %s
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj \
+// RUN:   -fparallel-codegen=2 %s -o - 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NO-OUTPUT
+
+// Every definition is emitted into one of the two objects, and the static
+// function stays local to the object that uses it.
+
+static int helper(int x) { return x * 2; }
+int first(int x) { return helper(x); }
+
+int second(int x) { return x + 1; }
+
+// CHECK-DAG: T first
+// CHECK-DAG: t helper
+// CHECK-DAG: T second
+// CHECK-NOT: T helper
+
+// NO-OUTPUT: error: invalid argument '-fparallel-codegen=2' only allowed with '-o <file>'
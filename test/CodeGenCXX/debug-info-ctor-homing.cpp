@@ -0,0 +1,59 @@
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -emit-llvm -debug-info-kind=limited -fuse-ctor-homing %s -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -emit-llvm -debug-info-kind=limited %s -o - | FileCheck %s --check-prefix=NOHOME
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -emit-llvm -debug-info-kind=standalone -fuse-ctor-homing %s -o - | FileCheck %s --check-prefix=NOHOME
+
+// The constructor of A is defined elsewhere, so A is only declared here.
+struct A {
+  A();
+  int i;
+};
+void f(A &a) { a.i = 1; }
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "A",{{.*}}flags: DIFlagFwdDecl
+// NOHOME-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "A",{{.*}}elements:
+
+// The constructor of B is emitted here, so B is described completely.
+struct B {
+  B();
+  int i;
+};
+B::B() : i(0) {}
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "B",{{.*}}elements:
+
+// An aggregate can be created without calling a constructor.
+struct C {
+  int i;
+};
+void g(C &c) { c.i = 1; }
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "C",{{.*}}elements:
+
+// So can a class with a constexpr constructor.
+struct D {
+  constexpr D(int i) : i(i) {}
+  int i;
+};
+void h(D &d) { d.i = 1; }
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "D",{{.*}}elements:
+
+// Objects of E and F can only be copied or moved from others, never created
+// from scratch, so no constructor that creates one may ever be emitted.
+struct E {
+  E(const E &);
+  E(E &&);
+  int i;
+};
+void k(E &e) { e.i = 1; }
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "E",{{.*}}elements:
+
+struct F {
+  F(int) = delete;
+  F(const F &);
+  int i;
+};
+void l(F &f) { f.i = 1; }
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "F",{{.*}}elements:
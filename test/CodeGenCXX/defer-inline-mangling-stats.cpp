@@ -0,0 +1,30 @@
+// REQUIRES: asserts
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -std=c++11 -emit-llvm \
+// RUN:   -fdefer-inline-mangling -mllvm -stats -o - %s 2>&1 \
+// RUN:   | FileCheck %s --implicit-check-not=unused --implicit-check-not=twiceIs
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -std=c++11 -emit-llvm \
+// RUN:   -mllvm -stats -o - %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NO-DEFER
+
+// -fdefer-inline-mangling only changes when names are mangled. The same
+// functions are emitted either way; the unreferenced ones never are.
+
+// Never referenced, so never mangled.
+inline int unused() { return 0; }
+
+// Never referenced, so neither it nor twice<short> is mangled.
+template <typename T> T twice(T t) { return t + t; }
+inline int unusedCaller() { return twice<short>(1); }
+
+// Mangled when callUsedCaller and then usedCaller are emitted.
+inline long usedCaller() { return twice(2L); }
+long callUsedCaller() { return usedCaller(); }
+
+// CHECK-DAG: define i64 @_Z14callUsedCallerv()
+// CHECK-DAG: define linkonce_odr i64 @_Z10usedCallerv()
+// CHECK-DAG: define linkonce_odr i64 @_Z5twiceIlET_S0_(
+
+// CHECK-DAG: 5 codegen - The # of deferred functions whose names were not mangled up front
+// CHECK-DAG: 2 codegen - The # of those functions that had to be mangled later
+
+// NO-DEFER-NOT: codegen - The # of
@@ -0,0 +1,49 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -std=c++11 -emit-llvm \
+// RUN:   -o - %s | FileCheck %s --implicit-check-not=unused --implicit-check-not=twiceIs
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -std=c++11 -emit-llvm \
+// RUN:   -fdefer-inline-mangling -o - %s \
+// RUN:   | FileCheck %s --implicit-check-not=unused --implicit-check-not=twiceIs
+
+// -fdefer-inline-mangling must not change which functions are emitted.
+
+inline int unused() { return 0; }
+
+inline int declaredFirst();
+int callDeclaredFirst() { return declaredFirst(); }
+inline int declaredFirst() { return 1; }
+
+inline int definedFirst() { return 2; }
+int callDefinedFirst() { return definedFirst(); }
+
+template <typename T> T twice(T t) { return t + t; }
+inline int unusedCaller() { return twice<short>(3); }
+inline long usedCaller() { return twice(4L); }
+long callUsedCaller() { return usedCaller(); }
+
+struct A {
+  virtual int f();
+};
+struct B {
+  virtual int g();
+};
+struct C : A, B {
+  int g() override;
+};
+int C::g() { return 5; }
+
+// The definition of a function whose name is only referenced by an alias
+// must still be emitted.
+inline int aliased() { return 6; }
+extern "C" int aliasOfAliased() __attribute__((alias("_Z7aliasedv")));
+
+// CHECK-DAG: @aliasOfAliased = alias i32 (), i32 ()* @_Z7aliasedv
+// CHECK-DAG: define i32 @_Z17callDeclaredFirstv()
+// CHECK-DAG: define linkonce_odr i32 @_Z13declaredFirstv()
+// CHECK-DAG: define i32 @_Z16callDefinedFirstv()
+// CHECK-DAG: define linkonce_odr i32 @_Z12definedFirstv()
+// CHECK-DAG: define i64 @_Z14callUsedCallerv()
+// CHECK-DAG: define linkonce_odr i64 @_Z10usedCallerv()
+// CHECK-DAG: define linkonce_odr i64 @_Z5twiceIlET_S0_(
+// CHECK-DAG: define i32 @_ZN1C1gEv(
+// CHECK-DAG: define i32 @_ZThn8_N1C1gEv(
+// CHECK-DAG: define linkonce_odr i32 @_Z7aliasedv()
@@ -0,0 +1,66 @@
+// Reusing cached manglings must not change any name in the output, including
+// the names of local, unnamed and block-scope entities whose manglings are
+// not cached.
+// RUN: %clang_cc1 -std=c++14 -fblocks -triple x86_64-unknown-linux-gnu -O1 -disable-llvm-passes -debug-info-kind=limited -emit-llvm -o %t.cached %s
+// RUN: %clang_cc1 -std=c++14 -fblocks -triple x86_64-unknown-linux-gnu -O1 -disable-llvm-passes -debug-info-kind=limited -fno-mangled-name-cache -emit-llvm -o %t.uncached %s
+// RUN: diff %t.cached %t.uncached
+// RUN: FileCheck %s < %t.cached
+
+namespace ns {
+template <typename T, int N> struct Array {
+  T Elems[N];
+  virtual ~Array() {}
+  virtual T get(int I) const { return Elems[I]; }
+};
+
+template <typename... Ts> struct Tuple {};
+
+template <typename T> T identity(T V) { return V; }
+}
+
+struct Outer {
+  struct {
+    int X;
+    virtual int f() { return X; }
+  } Unnamed1;
+  struct {
+    long Y;
+    virtual long f() { return Y; }
+  } Unnamed2;
+};
+
+enum class Color { Red, Green };
+
+int use(int (^Block)(int));
+
+int local() {
+  struct Local {
+    virtual int g() { return 1; }
+  };
+  auto Lambda = [](int V) { return V + 1; };
+  return Local().g() + Lambda(1) + use(^(int V) {
+    struct InBlock {
+      virtual int h() { return 2; }
+    };
+    static int Counter;
+    return InBlock().h() + V + ++Counter;
+  }) + use(^(int V) {
+    static int Counter;
+    return V + ++Counter;
+  });
+}
+
+int test() {
+  ns::Array<ns::Tuple<int, long, ns::Array<char, 2>>, 3> A1;
+  ns::Array<Color, 4> A2;
+  Outer O;
+  return local() + O.Unnamed1.f() + (int)O.Unnamed2.f() + (int)A2.get(0) +
+         ns::identity(1) + (ns::identity(Color::Red) == Color::Red);
+}
+
+// CHECK-DAG: @_ZTVN2ns5ArrayINS_5TupleIJilNS0_IcLi2EEEEEELi3EEE =
+// CHECK-DAG: @_ZTSN2ns5ArrayI5ColorLi4EEE =
+// CHECK-DAG: define {{.*}} @_ZN2ns8identityIiEET_S1_(
+// CHECK-DAG: define {{.*}} @_ZN5OuterUt_1fEv(
+// CHECK-DAG: define {{.*}} @_ZN5OuterUt0_1fEv(
+// CHECK-DAG: identifier: "_ZTSN2ns5ArrayI5ColorLi4EEE"
@@ -0,0 +1,52 @@
+// RUN: echo "# vtable owners" > %t.here
+// RUN: echo "_ZTV1A %s" >> %t.here
+// RUN: echo "_ZTV1BIiE	%s" >> %t.here
+// RUN: %clang_cc1 %s -triple=x86_64-unknown-linux-gnu -fvtable-owners=%t.here -emit-llvm -o - | FileCheck --check-prefix=CHECK-HERE %s
+
+// RUN: echo "_ZTV1A %t.other.cpp" > %t.elsewhere
+// RUN: echo "_ZTV1BIiE %t.other.cpp" >> %t.elsewhere
+// RUN: %clang_cc1 %s -triple=x86_64-unknown-linux-gnu -fvtable-owners=%t.elsewhere -emit-llvm -o %t.ll
+// RUN: FileCheck --check-prefix=CHECK-ELSEWHERE %s < %t.ll
+// RUN: FileCheck --check-prefix=CHECK-NO-RTTI %s < %t.ll
+
+// RUN: echo "_ZTV1A" > %t.malformed
+// RUN: not %clang_cc1 %s -triple=x86_64-unknown-linux-gnu -fvtable-owners=%t.malformed -emit-llvm -o /dev/null 2>&1 | FileCheck --check-prefix=CHECK-MALFORMED %s
+// RUN: not %clang_cc1 %s -triple=x86_64-unknown-linux-gnu -fvtable-owners=%t.missing -emit-llvm -o /dev/null 2>&1 | FileCheck --check-prefix=CHECK-MISSING %s
+
+// A class without a key function.
+struct A {
+  virtual void f() {}
+};
+
+// An implicit instantiation.
+template <typename T> struct B {
+  virtual void g() {}
+};
+
+// A class that the file does not mention.
+struct C {
+  virtual void h() {}
+};
+
+void use() {
+  A a;
+  B<int> b;
+  C c;
+}
+
+// CHECK-HERE-DAG: @_ZTV1A = weak_odr unnamed_addr constant
+// CHECK-HERE-DAG: @_ZTS1A = weak_odr constant
+// CHECK-HERE-DAG: @_ZTI1A = weak_odr constant
+// CHECK-HERE-DAG: @_ZTV1BIiE = weak_odr unnamed_addr constant
+// CHECK-HERE-DAG: @_ZTI1BIiE = weak_odr constant
+// CHECK-HERE-DAG: @_ZTV1C = linkonce_odr unnamed_addr constant
+
+// CHECK-ELSEWHERE-DAG: @_ZTV1A = external unnamed_addr constant
+// CHECK-ELSEWHERE-DAG: @_ZTV1BIiE = external unnamed_addr constant
+// CHECK-ELSEWHERE-DAG: @_ZTV1C = linkonce_odr unnamed_addr constant
+
+// CHECK-NO-RTTI-NOT: @_ZTI1A = {{.*}}constant
+// CHECK-NO-RTTI-NOT: @_ZTI1BIiE = {{.*}}constant
+
+// CHECK-MALFORMED: error: malformed line 1 in vtable owners file
+// CHECK-MISSING: error: could not read vtable owners file
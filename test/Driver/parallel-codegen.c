@@ -0,0 +1,47 @@
+// cc1 writes the partitions to temporary objects, and a relocatable link
+// merges them into the object that the compile job produces.
+// RUN: %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=3 -### %s \
+// RUN:   2>&1 | FileCheck %s
+// CHECK: "-cc1"
+// CHECK-SAME: "-fparallel-codegen=3"
+// CHECK-SAME: "-o" "[[PART:[^"]*]].o"
+// CHECK: "{{.*}}ld{{(.exe)?}}" "-r" "-o" "[[OBJ:[^"]*]].o" "[[PART]].o" "[[PART]].1.o" "[[PART]].2.o"
+// CHECK: "{{.*}}ld{{(.exe)?}}"
+// CHECK-SAME: "[[OBJ]].o"
+
+// The same happens for an object that the driver does not link.
+// RUN: %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=2 -c \
+// RUN:   -o %t.obj -### %s 2>&1 | FileCheck %s --check-prefix=OBJECT
+// RUN: %clang -target x86_64-apple-darwin -fparallel-codegen=2 -c \
+// RUN:   -o %t.obj -### %s 2>&1 | FileCheck %s --check-prefix=OBJECT
+// OBJECT: "-cc1"
+// OBJECT-SAME: "-fparallel-codegen=2"
+// OBJECT-SAME: "-o" "[[PART:[^"]*]].o"
+// OBJECT: "{{.*}}ld{{(.exe)?}}" "-r" "-o" "{{[^"]*}}parallel-codegen.c.tmp.obj" "[[PART]].o" "[[PART]].1.o"
+// OBJECT-NOT: "-cc1"
+
+// Assembly is not partitioned.
+// RUN: %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=2 -S \
+// RUN:   -### %s 2>&1 | FileCheck %s --check-prefix=ASM
+// RUN: %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=2 \
+// RUN:   -fno-integrated-as -c -### %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ASM
+// ASM: "-cc1"
+// ASM-NOT: "-fparallel-codegen=
+// ASM-NOT: "-r"
+
+// One partition needs nothing from the driver.
+// RUN: %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=1 -c -### \
+// RUN:   %s 2>&1 | FileCheck %s --check-prefix=ONE
+// ONE: "-cc1"
+// ONE-NOT: "-fparallel-codegen=
+// ONE-NOT: "-r"
+
+// link.exe cannot merge objects.
+// RUN: not %clang -target x86_64-pc-windows-msvc -fparallel-codegen=2 -c \
+// RUN:   -### %s 2>&1 | FileCheck %s --check-prefix=MSVC
+// MSVC: error: unsupported option '-fparallel-codegen=2' for target 'x86_64-pc-windows-msvc{{.*}}'
+
+// RUN: not %clang -target x86_64-unknown-linux-gnu -fparallel-codegen=two \
+// RUN:   -### %s 2>&1 | FileCheck %s --check-prefix=INVALID
+// INVALID: error: invalid integral value 'two' in '-fparallel-codegen=two'
@@ -0,0 +1,47 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -fast-memory-report %s 2>&1 | FileCheck %s
+
+template <typename T> struct Box {
+  T value;
+  T get() const { return value; }
+};
+
+struct Name { Name(const char *); };
+
+int use() {
+  Box<int> b = {1};
+  Name n("name");
+  return b.get() + 2;
+}
+
+// Statements are found through the declaration that owns them, including
+// the bodies of lambdas and default arguments.
+int lambda(int x = sizeof(Name)) {
+  return [x] { return x * 3; }();
+}
+
+// CHECK: *** AST Memory Report:
+// CHECK: bytes in {{[0-9]+}} allocations through the ASTContext
+// CHECK: bytes reserved by the AST allocator
+// CHECK: Declarations (top
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  CXXRecord{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  ClassTemplateSpecialization{{$}}
+// CHECK: Statements (top
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  IntegerLiteral{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  ReturnStmt{{$}}
+// Nodes whose storage is obtained with ASTContext::Allocate rather than
+// Stmt's operator new are counted too.
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  DeclRefExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  MemberExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  ImplicitCastExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  StringLiteral{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  CXXConstructExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  CXXMemberCallExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  UnaryExprOrTypeTraitExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  LambdaExpr{{$}}
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  BinaryOperator{{$}}
+// CHECK: Types (top
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  Builtin{{$}}
+// CHECK: Files (top
+// CHECK-DAG: ast-memory-report.cpp{{$}}
+// CHECK: Template instantiations (top
+// CHECK-DAG: {{[0-9]+ +[0-9]+}}  Box<int>{{$}}
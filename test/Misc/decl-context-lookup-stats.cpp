@@ -0,0 +1,14 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// The lookup tables of the translation unit and of 'ns' are built; 'f' is
+// an overload set, so its entry holds a vector of declarations.
+namespace ns {
+  int f(int);
+  int f(long);
+  struct S {};
+}
+
+int use() { return ns::f(0) + sizeof(ns::S); }
+
+// CHECK: {{[1-9][0-9]*}} decl context lookup tables, {{[1-9][0-9]*}} entries ({{[1-9][0-9]*}} with several declarations), {{[1-9][0-9]*}} bytes
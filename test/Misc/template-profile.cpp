@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -ftemplate-profile-output=%t.folded %s 2>&1 | FileCheck %s
+// RUN: FileCheck --check-prefix=FOLDED %s < %t.folded
+
+template <int N> struct Fib {
+  static const int value = Fib<N - 1>::value + Fib<N - 2>::value;
+};
+template <> struct Fib<1> { static const int value = 1; };
+template <> struct Fib<0> { static const int value = 0; };
+
+template <typename T> T identity(T t) { return t; }
+
+int x = Fib<8>::value + identity(1);
+
+// CHECK: *** Template Instantiation Profile:
+// CHECK: template instantiations,
+// CHECK: Templates (top
+// CHECK: Total(s) Self(s) Count Nested Bytes Name
+// CHECK-DAG: {{ 7 +[0-9]+ +[0-9]+}}  Fib{{$}}
+// CHECK-DAG: identity (deduction)
+// CHECK: Specializations (top
+// CHECK-DAG: {{ 1 +6 +[0-9]+}}  Fib<8>{{$}}
+// CHECK-DAG: identity<int>{{$}}
+
+// FOLDED-DAG: {{^}}Fib<8>;Fib<7>;Fib<6> {{[0-9]+$}}
+// FOLDED-DAG: {{^}}identity<int> {{[0-9]+$}}
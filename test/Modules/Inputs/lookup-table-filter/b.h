@@ -0,0 +1,4 @@
+#include "a.h"
+namespace ns {
+  int fb();
+}
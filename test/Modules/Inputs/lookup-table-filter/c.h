@@ -0,0 +1,4 @@
+#include "b.h"
+namespace ns {
+  int fc();
+}
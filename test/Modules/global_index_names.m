@@ -0,0 +1,22 @@
+// RUN: rm -rf %t
+// Build the modules and the global module index.
+// RUN: %clang_cc1 -fmodules-cache-path=%t -fdisable-module-hash -fmodules -fimplicit-module-maps -I %S/Inputs %s -verify
+// RUN: llvm-bcanalyzer %t/MethodPoolA.pcm | FileCheck -check-prefix=CHECK-PCM %s
+// RUN: ls %t | grep modules.idx
+// Use the name filters in the global module index to skip module files.
+// RUN: %clang_cc1 -fmodules-cache-path=%t -fdisable-module-hash -fmodules -fimplicit-module-maps -I %S/Inputs %s -verify -print-stats 2>&1 | FileCheck -check-prefix=CHECK-STATS %s
+
+// CHECK-PCM: LOOKUP_NAME_FILTER
+// CHECK-STATS: *** Global Module Index Statistics:
+// CHECK-STATS: name filter checks ruled out a module
+
+@import MethodPoolA;
+@import MethodPoolB;
+
+void testKnownMethod(id object) {
+  [object method1];
+}
+
+void testUnknownMethod(id object) {
+  [object methodInNoModule]; // expected-warning{{instance method '-methodInNoModule' not found (return type defaults to 'id')}}
+}
@@ -0,0 +1,15 @@
+// RUN: rm -rf %t
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t -I %S/Inputs/lookup-table-filter %s -verify -print-stats 2>&1 | FileCheck %s
+
+// Each of the modules has its own lookup table for 'ns'. Looking up a name
+// that none of them declares should not need to probe any of those tables.
+// CHECK: declcontext lookup table probes skipped by filters
+
+// expected-no-diagnostics
+#include "c.h"
+
+namespace ns {
+  void local();
+}
+
+int k = ns::fa() + ns::fb() + ns::fc();
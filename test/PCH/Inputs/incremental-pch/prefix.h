@@ -0,0 +1,3 @@
+#include "other.h"
+
+int prefix_function(int);
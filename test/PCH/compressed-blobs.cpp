@@ -0,0 +1,62 @@
+// REQUIRES: zlib
+
+// Test this without pch.
+// RUN: %clang_cc1 -include %s -fsyntax-only -verify %s
+
+// Test with a compressed pch.
+// RUN: %clang_cc1 -emit-pch -fcompress-ast-blobs -o %t %s
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only -verify %s
+// RUN: llvm-bcanalyzer -dump %t | FileCheck %s
+//
+// CHECK: <DECL_CONTEXT_LEXICAL_COMPRESSED
+// CHECK: <IDENTIFIER_TABLE_COMPRESSED
+
+// Without the flag, nothing is compressed.
+// RUN: %clang_cc1 -emit-pch -o %t.uncompressed %s
+// RUN: llvm-bcanalyzer -dump %t.uncompressed | FileCheck --check-prefix=CHECK-PLAIN %s
+//
+// CHECK-PLAIN-NOT: _COMPRESSED
+
+#ifndef HEADER
+#define HEADER
+
+#define FIELD(N) int field_##N;
+#define FUNC(N) int func_##N(int);
+
+#define FIELDS16(P) FIELD(P##0) FIELD(P##1) FIELD(P##2) FIELD(P##3) \
+                    FIELD(P##4) FIELD(P##5) FIELD(P##6) FIELD(P##7) \
+                    FIELD(P##8) FIELD(P##9) FIELD(P##a) FIELD(P##b) \
+                    FIELD(P##c) FIELD(P##d) FIELD(P##e) FIELD(P##f)
+#define FIELDS256 FIELDS16(0) FIELDS16(1) FIELDS16(2) FIELDS16(3) \
+                  FIELDS16(4) FIELDS16(5) FIELDS16(6) FIELDS16(7) \
+                  FIELDS16(8) FIELDS16(9) FIELDS16(a) FIELDS16(b) \
+                  FIELDS16(c) FIELDS16(d) FIELDS16(e) FIELDS16(f)
+
+#define FUNCS16(P) FUNC(P##0) FUNC(P##1) FUNC(P##2) FUNC(P##3) \
+                   FUNC(P##4) FUNC(P##5) FUNC(P##6) FUNC(P##7) \
+                   FUNC(P##8) FUNC(P##9) FUNC(P##a) FUNC(P##b) \
+                   FUNC(P##c) FUNC(P##d) FUNC(P##e) FUNC(P##f)
+#define FUNCS256 FUNCS16(0) FUNCS16(1) FUNCS16(2) FUNCS16(3) \
+                 FUNCS16(4) FUNCS16(5) FUNCS16(6) FUNCS16(7) \
+                 FUNCS16(8) FUNCS16(9) FUNCS16(a) FUNCS16(b) \
+                 FUNCS16(c) FUNCS16(d) FUNCS16(e) FUNCS16(f)
+
+struct Big {
+  FIELDS256
+};
+
+namespace ns {
+  FUNCS256
+}
+
+#else
+
+int use(Big &B) {
+  return B.field_00 + B.field_7c + B.field_ff + ns::func_a5(B.field_5a);
+}
+
+int bad(Big &B) {
+  return B.field_100; // expected-error {{no member named 'field_100' in 'Big'}}
+}
+
+#endif
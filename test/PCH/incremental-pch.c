@@ -0,0 +1,74 @@
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: cp %S/Inputs/incremental-pch/prefix.h %S/Inputs/incremental-pch/other.h %t
+// RUN: touch -m -a -t 201101010000 %t/prefix.h %t/other.h
+//
+// The first build always produces the PCH file.
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+//
+// Nothing changed, so the second build keeps it.
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=REUSE %s
+//
+// The dependency file is still written when the PCH file is kept.
+// RUN: rm -f %t/prefix.d
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -dependency-file %t/prefix.d -MT prefix.pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=REUSE %s
+// RUN: FileCheck --check-prefix=DEPS %s < %t/prefix.d
+//
+// Without -fincremental-pch, we always rebuild.
+// RUN: %clang_cc1 -x c-header -emit-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+//
+// An included header whose modification time differs from the one recorded
+// in the PCH file forces a rebuild, even if it is older than the PCH file.
+// RUN: touch -m -a -t 201001010000 %t/other.h
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=REUSE %s
+//
+// So does an edit that keeps the modification time but changes the size.
+// RUN: echo 'struct Other { int x, y; };' > %t/other.h
+// RUN: touch -m -a -t 201001010000 %t/other.h
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+//
+// Without recorded timestamps, the PCH file is never kept.
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -fno-pch-timestamp \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -fno-pch-timestamp \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+//
+// Options that are not checked when the PCH file is loaded, but that affect
+// its contents, force a rebuild too: code generation options, header search
+// options and AST writer options.
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -debug-info-kind=limited \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -I %t \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -fcompress-ast-blobs \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -fcompress-ast-blobs \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=REUSE %s
+//
+// So does a change to the preprocessor options.
+// RUN: %clang_cc1 -x c-header -emit-pch -fincremental-pch -Rincremental-pch -DFOO \
+// RUN:   -o %t/prefix.pch %t/prefix.h 2>&1 | FileCheck --check-prefix=BUILD --allow-empty %s
+//
+// The kept PCH file is still usable.
+// RUN: %clang_cc1 -include-pch %t/prefix.pch -DFOO -fsyntax-only -verify %s
+//
+// REUSE: remark: precompiled header '{{.*}}prefix.pch' is up to date; not regenerating it
+// BUILD-NOT: remark
+// DEPS: prefix.pch:
+// DEPS: prefix.h
+// DEPS: other.h
+
+// expected-no-diagnostics
+
+int use(struct Other *O) { return prefix_function(O->x); }
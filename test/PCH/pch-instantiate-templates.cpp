@@ -0,0 +1,47 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include %s -emit-llvm -o - %s | FileCheck %s
+
+// With -fpch-instantiate-templates, the instantiations are performed (and
+// diagnosed) while building the PCH file.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -x c++-header -emit-pch \
+// RUN:   -fpch-instantiate-templates -o %t %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -x c++-header -emit-pch \
+// RUN:   -fpch-instantiate-templates -DBAD -verify -o %t.bad %s
+//
+// Users of the PCH file still emit the definitions they need.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include-pch %t -emit-llvm -o - %s | FileCheck %s
+
+// CHECK-DAG: define {{.*}}i32 @_Z3usev()
+// CHECK-DAG: define linkonce_odr {{.*}}i32 @_Z5twiceIiET_S0_(
+// CHECK-DAG: define linkonce_odr {{.*}}i32 @_ZNK3BoxIiE3getEv(
+
+#ifndef HEADER
+#define HEADER
+
+template <typename T> T twice(T t) { return t + t; }
+
+template <typename T> struct Box {
+  T Value;
+  T get() const { return Value; }
+};
+
+inline int prefix_use(Box<int> &B) { return twice(B.get()); }
+
+#ifdef BAD
+template <typename T> struct Bad {
+  T get() const { return "not a number"; } // expected-error {{cannot initialize return object of type 'double'}}
+};
+
+inline double bad_use(Bad<double> &B) {
+  return B.get(); // expected-note {{in instantiation of member function 'Bad<double>::get' requested here}}
+}
+#endif
+
+#else
+
+int use() {
+  Box<int> B = {21};
+  return prefix_use(B);
+}
+
+#endif
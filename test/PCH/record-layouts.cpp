@@ -0,0 +1,122 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include %s -fsyntax-only -verify %s
+
+// Test with a pch that stores record layouts.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-pch -fpch-record-layouts -o %t %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t -fsyntax-only -verify %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// RUN: llvm-bcanalyzer -dump %t | FileCheck --check-prefix=CHECK-BC %s
+//
+// CHECK: {{[1-9][0-9]*}}/{{[1-9][0-9]*}} record layouts read
+// CHECK-BC: <RECORD_LAYOUTS
+
+// Without the flag, no layouts are stored.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-pch -o %t.plain %s
+// RUN: llvm-bcanalyzer -dump %t.plain | FileCheck --check-prefix=CHECK-PLAIN %s
+//
+// CHECK-PLAIN-NOT: <RECORD_LAYOUTS
+
+// Stored layouts are not used when padding warnings are requested.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t -fsyntax-only -Wpadded %s 2>&1 | FileCheck --check-prefix=CHECK-PADDED %s
+//
+// CHECK-PADDED: warning: padding size of 'Plain' with 2 bytes to alignment boundary
+
+// ... including when they are only enabled for a field.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-pch -fpch-record-layouts -DFIELD_WARNING -o %t.field %s 2>/dev/null
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t.field -fsyntax-only -DFIELD_WARNING %s 2>&1 | FileCheck --check-prefix=CHECK-FIELD %s
+//
+// CHECK-FIELD: warning: padding struct 'FieldPadded' with 3 bytes to align 'i'
+
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+struct Plain {
+  char c;
+  int i;
+  short s;
+};
+
+struct Bits {
+  unsigned a : 3;
+  unsigned b : 7;
+  char c;
+};
+
+struct Empty {};
+
+struct Base {
+  virtual ~Base();
+  char b;
+};
+
+struct Derived : Empty, Base {
+  int d;
+};
+
+struct VLeft : virtual Base {
+  int l;
+};
+
+struct VRight : virtual Base {
+  int r;
+};
+
+struct Diamond : VLeft, VRight {
+  char x;
+};
+
+template <typename T> struct Wrapper {
+  char c;
+  T t;
+};
+
+template struct Wrapper<double>;
+
+// Only the layouts computed while building the PCH are stored. Uses like
+// these in a header are what cause them to be computed.
+static_assert(sizeof(Plain) == 12, "");
+static_assert(sizeof(Bits) == 4, "");
+static_assert(sizeof(Derived) == 16, "");
+static_assert(sizeof(Diamond) == 48, "");
+static_assert(sizeof(Wrapper<double>) == 16, "");
+
+// This record is not laid out in the PCH, so its layout is not stored.
+struct NotLaidOut {
+  char c;
+  double d;
+};
+
+#ifdef FIELD_WARNING
+struct FieldPadded {
+  char c;
+#pragma clang diagnostic push
+#pragma clang diagnostic warning "-Wpadded"
+  int i;
+#pragma clang diagnostic pop
+};
+#endif
+
+#else
+
+static_assert(sizeof(Plain) == 12, "");
+static_assert(__builtin_offsetof(Plain, i) == 4, "");
+static_assert(__builtin_offsetof(Plain, s) == 8, "");
+static_assert(sizeof(Bits) == 4, "");
+static_assert(__builtin_offsetof(Bits, c) == 2, "");
+static_assert(sizeof(Base) == 16, "");
+static_assert(sizeof(Derived) == 16, "");
+static_assert(sizeof(VLeft) == 32, "");
+static_assert(sizeof(Diamond) == 48, "");
+static_assert(sizeof(Wrapper<double>) == 16, "");
+static_assert(__builtin_offsetof(Wrapper<double>, t) == 8, "");
+static_assert(sizeof(NotLaidOut) == 16, "");
+
+Base *upcast(Diamond *D) { return D; }
+
+#ifdef FIELD_WARNING
+static_assert(sizeof(FieldPadded) == 8, "");
+#endif
+
+#endif
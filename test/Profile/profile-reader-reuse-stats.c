@@ -0,0 +1,27 @@
+// REQUIRES: asserts
+// RUN: llvm-profdata merge %S/Inputs/func-entry.proftext -o %t.profdata
+
+// A profile whose modification time is not in the past might still change
+// without its time changing, so it is read again for every input.
+// RUN: touch -m -a -t 209901010000 %t.profdata
+// RUN: %clang_cc1 %s %s -o /dev/null -disable-llvm-optzns -emit-llvm -fprofile-instrument-use-path=%t.profdata -mllvm -stats 2>&1 | FileCheck %s --check-prefix=REREAD
+
+// REREAD-NOT: profile readers reused
+// REREAD: 2 codegen - The # of indexed profile readers opened
+// REREAD-NOT: profile readers reused
+
+// A profile modified earlier is read once and its reader reused.
+// RUN: touch -m -a -t 200001010000 %t.profdata
+// RUN: %clang_cc1 %s %s -o /dev/null -disable-llvm-optzns -emit-llvm -fprofile-instrument-use-path=%t.profdata -mllvm -stats 2>&1 | FileCheck %s --check-prefix=REUSED
+
+// REUSED-DAG: 1 codegen - The # of indexed profile readers opened
+// REUSED-DAG: 1 codegen - The # of indexed profile readers reused from an earlier compile
+
+void foo(void);
+void foo() { return; }
+
+int main() {
+  int i;
+  for (i = 0; i < 10000; i++) foo();
+  return 0;
+}
@@ -0,0 +1,32 @@
+// The reader of an indexed profile is kept when a code generator is done
+// with it, and reused by the next code generator in the same process if the
+// file has not changed since. cc1 runs one code generator per input file.
+
+// RUN: llvm-profdata merge %S/Inputs/func-entry.proftext -o %t.profdata
+// RUN: %clang_cc1 %s %s -o - -disable-llvm-optzns -emit-llvm -fprofile-instrument-use-path=%t.profdata | FileCheck %s
+
+// A profile that was modified in the current second is read again, since it
+// could be modified again without a change to its modification time. One
+// that was modified earlier is reused.
+// RUN: touch -m -a -t 200001010000 %t.profdata
+// RUN: %clang_cc1 %s %s -o - -disable-llvm-optzns -emit-llvm -fprofile-instrument-use-path=%t.profdata | FileCheck %s
+
+void foo(void);
+
+// CHECK: @foo() #{{[0-9]}} !prof [[FOO:![0-9]+]]
+void foo() { return; }
+
+// CHECK: @main() #{{[0-9]}} !prof [[MAIN:![0-9]+]]
+int main() {
+  int i;
+  for (i = 0; i < 10000; i++) foo();
+  return 0;
+}
+
+// CHECK: [[FOO]] = !{!"function_entry_count", i64 1000}
+// CHECK: [[MAIN]] = !{!"function_entry_count", i64 1}
+
+// CHECK: @foo() #{{[0-9]}} !prof [[FOO2:![0-9]+]]
+// CHECK: @main() #{{[0-9]}} !prof [[MAIN2:![0-9]+]]
+// CHECK: [[FOO2]] = !{!"function_entry_count", i64 1000}
+// CHECK: [[MAIN2]] = !{!"function_entry_count", i64 1}
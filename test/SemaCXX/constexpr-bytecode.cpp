@@ -0,0 +1,113 @@
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify -fconstexpr-bytecode %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s
+// RUN: not %clang_cc1 -std=c++14 -fsyntax-only -fconstexpr-bytecode \
+// RUN:   -print-stats %s 2>&1 | FileCheck %s --check-prefix=STATS
+// RUN: not %clang_cc1 -std=c++14 -fsyntax-only -fconstexpr-bytecode \
+// RUN:   -print-stats -DGIVE_UP %s 2>&1 | FileCheck %s --check-prefix=GIVE-UP
+
+#ifdef GIVE_UP
+// Once the interpreter has given up on a call, the calls the AST walker
+// makes while evaluating it again are not offered to the interpreter, which
+// would give up on each of them in turn.
+constexpr int countdown(int n) { return n == 0 ? 1 / n : countdown(n - 1); }
+static_assert(countdown(200) == 0, "");
+
+// GIVE-UP: 0/{{[1-9]}} constexpr calls evaluated by the bytecode interpreter
+// GIVE-UP: {{[1-9]}} constexpr calls given up by the bytecode interpreter
+#else
+
+// The bytecode interpreter must produce the same values as the AST walker,
+// and must leave every diagnostic to it.
+
+constexpr int fib(int n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+static_assert(fib(20) == 6765, "");
+
+constexpr unsigned collatz(unsigned long long n) {
+  unsigned steps = 0;
+  while (n != 1) {
+    n = n % 2 ? 3 * n + 1 : n / 2;
+    ++steps;
+  }
+  return steps;
+}
+static_assert(collatz(27) == 111, "");
+
+constexpr bool isPrime(int n) {
+  if (n < 2)
+    return false;
+  for (int d = 2; d * d <= n; ++d)
+    if (n % d == 0)
+      return false;
+  return true;
+}
+constexpr int countPrimes(int limit) {
+  int count = 0;
+  for (int i = 0; i < limit; i++) {
+    if (!isPrime(i))
+      continue;
+    count += 1;
+  }
+  return count;
+}
+static_assert(countPrimes(1000) == 168, "");
+
+constexpr int log2(unsigned v) {
+  int r = -1;
+  do {
+    v >>= 1;
+    ++r;
+  } while (v);
+  return r;
+}
+static_assert(log2(1) == 0 && log2(1024) == 10, "");
+
+constexpr int firstSetBit(unsigned long long v) {
+  int i = 0;
+  while (true) {
+    if (v & 1)
+      break;
+    v >>= 1, ++i;
+  }
+  return i;
+}
+static_assert(firstSetBit(1ULL << 63) == 63, "");
+
+enum class Color : unsigned char { Red = 1, Green = 2, Blue = 4 };
+constexpr int shifted(Color c) { return static_cast<int>(c) << 4; }
+static_assert(shifted(Color::Blue) == 64, "");
+
+const int Base = 10;
+constexpr long scaled(int x) { return x * Base + sizeof(long); }
+static_assert(scaled(4) == 40 + sizeof(long), "");
+
+constexpr unsigned wrap(unsigned x) { return x + 1; }
+static_assert(wrap(~0u) == 0, "");
+
+constexpr signed char increment(signed char c) { return ++c; }
+static_assert(increment(127) == -128, "");
+
+constexpr long long negate(long long x) { return -x; }
+static_assert(negate(-5) == 5, "");
+
+constexpr bool inRange(int x) { return (x >= 0 && x < 10) || x == 42; }
+static_assert(inRange(3) && inRange(42) && !inRange(-1), "");
+
+constexpr int twice(int x) { return x * 2; }
+static_assert(twice(1 << 30), ""); // expected-error {{static_assert expression is not an integral constant expression}} \
+                                   // expected-note {{value 2147483648 is outside the range of representable values of type 'int'}} \
+                                   // expected-note {{in call to 'twice(1073741824)'}}
+
+constexpr int divide(int a, int b) { return a / b; }
+static_assert(divide(1, 0), ""); // expected-error {{static_assert expression is not an integral constant expression}} \
+                                 // expected-note {{division by zero}} \
+                                 // expected-note {{in call to 'divide(1, 0)'}}
+
+constexpr int shiftLeft(int a, int b) { return a << b; }
+static_assert(shiftLeft(1, 3) == 8, "");
+static_assert(shiftLeft(1, 32), ""); // expected-error {{static_assert expression is not an integral constant expression}} \
+                                     // expected-note {{shift count 32 >= width of type 'int' (32 bits)}} \
+                                     // expected-note {{in call to 'shiftLeft(1, 32)'}}
+
+// STATS: {{[1-9][0-9]*}}/{{[0-9]+}} constexpr functions compiled to bytecode
+// STATS: {{[1-9][0-9]*}}/{{[0-9]+}} constexpr calls evaluated by the bytecode interpreter
+#endif
@@ -0,0 +1,74 @@
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify \
+// RUN:   -fno-constexpr-call-cache %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify -DLIMITS \
+// RUN:   -fconstexpr-depth 16 -fconstexpr-steps 1000 \
+// RUN:   -verify-ignore-unexpected=note %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify -DLIMITS \
+// RUN:   -fconstexpr-depth 16 -fconstexpr-steps 1000 \
+// RUN:   -verify-ignore-unexpected=note -fno-constexpr-call-cache %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=STATS
+
+#ifdef LIMITS
+
+// A cached result is charged the steps and the call depth its evaluation
+// took, so the limits are reached exactly as they would be without the
+// cache.
+constexpr int spin(int n) {
+  int s = 0;
+  for (int i = 0; i < n; ++i)
+    s += i;
+  return s;
+}
+static_assert(spin(600) == 179700, "");
+static_assert(spin(600) + spin(600) == 359400, ""); // expected-error {{not an integral constant expression}}
+
+constexpr int down(int n) { return n == 0 ? 0 : down(n - 1); }
+static_assert(down(10) == 0, "");
+constexpr int nest(int n) { return n == 0 ? down(10) : nest(n - 1); }
+static_assert(nest(4) == 0, "");
+static_assert(nest(5) == 0, ""); // expected-error {{not an integral constant expression}}
+
+#else
+
+// Calls with the same integer arguments are only evaluated once.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+static_assert(fib(24) == 46368, "");
+
+// A call whose evaluation was diagnosed is not cached; each use produces
+// the same notes.
+constexpr int checkedDiv(int a, int b) { return a / b; } // expected-note 2{{division by zero}}
+constexpr int q1 = checkedDiv(1, 0); // expected-error {{constant expression}} expected-note {{in call to}}
+constexpr int q2 = checkedDiv(1, 0); // expected-error {{constant expression}} expected-note {{in call to}}
+
+// Calls taking pointers are not cached: the key would have to describe the
+// object pointed to.
+constexpr int table[] = {1, 2, 3};
+constexpr int at(const int *p, int i) { return p[i]; }
+static_assert(at(table, 2) == 3, "");
+static_assert(at(table + 1, 1) == 3, "");
+
+// Member functions are not cached: the value of the object is part of the
+// call.
+struct Counter {
+  int n;
+  constexpr int next() const { return n + 1; }
+};
+static_assert(Counter{1}.next() == 2, "");
+static_assert(Counter{2}.next() == 3, "");
+
+// A variable whose initializer is being evaluated must not leak its partial
+// value into the cache.
+struct S {
+  int a, b;
+};
+constexpr int get(int) { return 0; }
+constexpr S s = {get(1), get(1) + 1};
+static_assert(s.b == 1, "");
+
+#endif
+
+// STATS: cacheable constexpr calls found in the cache
@@ -0,0 +1,77 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -print-stats %s 2>&1 | FileCheck %s
+
+// Conversions of class-typed arguments to the parameters of overload
+// candidates are computed once per pair of types and reused afterwards.
+// Make sure that reused conversion sequences still produce the same overload
+// resolution results and diagnostics.
+
+struct Stream {};
+struct Name { Name(const char *); };
+struct Number { operator int() const; };
+struct Plain {};
+
+void put(Stream &, int); // expected-note 2{{candidate function not viable: no known conversion from 'Plain' to 'int' for 2nd argument}}
+void put(Stream &, Name); // expected-note 2{{candidate function not viable: no known conversion from 'Plain' to 'Name' for 2nd argument}}
+
+void test(Stream &S, Number N, Plain P) {
+  put(S, N);
+  put(S, N);
+  put(S, "name");
+  put(S, P); // expected-error {{no matching function for call to 'put'}}
+  put(S, P); // expected-error {{no matching function for call to 'put'}}
+}
+
+struct Base {};
+struct Derived : Base {};
+
+int &pick(Base);
+float &pick(int);
+
+void test2(Derived D, const Derived CD) {
+  int &r1 = pick(D);
+  int &r2 = pick(D);
+  int &r3 = pick(CD);
+  int &r4 = pick(static_cast<Derived &&>(D));
+}
+
+// A converting constructor template is only viable for some argument types;
+// each argument type gets its own cached result.
+struct Tagged { typedef int tag; };
+struct Untagged {};
+struct Wrapper {
+  template <typename T> Wrapper(T, typename T::tag * = 0);
+};
+
+int &wrap(Wrapper);
+float &wrap(...);
+
+void test3(Tagged T, Untagged U) {
+  int &r1 = wrap(T);
+  float &r2 = wrap(U);
+  int &r3 = wrap(T);
+  float &r4 = wrap(U);
+}
+
+// An explicit conversion function is a candidate when direct-initializing
+// the parameter of a constructor, but not when copy-initializing the
+// parameter of an ordinary function, even though both convert to the same
+// parameter type.
+struct Target {};
+struct Other {};
+struct Source {
+  explicit operator Target() const;
+  operator Other() const;
+};
+
+int &choose(const Target &);
+float &choose(const Other &);
+
+void test4(Source S) {
+  float &r1 = choose(S);
+  Target T1(S);
+  float &r2 = choose(S);
+  Target T2(S);
+}
+
+// CHECK: {{[1-9][0-9]*}}/{{[0-9]+}} cacheable candidate conversions found in the cache.
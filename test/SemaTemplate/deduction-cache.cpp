@@ -0,0 +1,60 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// Deduced specializations are remembered per template, explicit template
+// arguments, argument types and value kinds, and, if there are explicit
+// template arguments, context of the call. Make sure that reusing them
+// doesn't change the outcome of overload resolution.
+
+template <class T> struct remove_reference { typedef T type; };
+template <class T> struct remove_reference<T &> { typedef T type; };
+
+template <class T> T &&forward(typename remove_reference<T>::type &t);
+template <class T> typename remove_reference<T>::type &&move(T &&t);
+
+template <class T> int &category(T &&);
+template <class T> float &category(const T &, int = 0);
+
+struct S {};
+
+void test_value_kinds(S s, const S cs) {
+  int &r1 = category(s);
+  int &r2 = category(s);
+  int &r3 = category(move(s));
+  int &r4 = category(move(s));
+  int &r5 = category(forward<S &>(s));
+  int &r6 = category(forward<S>(s));
+
+  S &&x1 = move(s);
+  S &&x2 = move(s);
+  const S &&x3 = move(cs);
+}
+
+// Without explicit template arguments, deductions are reused across function
+// bodies.
+void test_other_body(S s, const S cs) {
+  int &r1 = category(s);
+  S &&x1 = move(s);
+  const S &&x2 = move(cs);
+}
+
+// Explicit template arguments are substituted in the context of the call, so
+// whether substitution succeeds can depend on access control there.
+class Secret {
+  typedef int type;
+  friend void friend_fn();
+};
+
+template <class T> typename T::type peek(int);
+template <class T> void peek(...);
+
+void friend_fn() {
+  int i = peek<Secret>(0);
+  int j = peek<Secret>(0);
+}
+
+void stranger() {
+  int i = peek<Secret>(0); // expected-error {{cannot initialize a variable of type 'int' with an rvalue of type 'void'}}
+}
+
+// CHECK: {{[1-9][0-9]*}}/{{[0-9]+}} cacheable template argument deductions found in the cache.
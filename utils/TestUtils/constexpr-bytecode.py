@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+#===- constexpr-bytecode.py - Benchmark constexpr evaluation --------------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates translation units dominated by constant evaluation -- loops
+# counting primes, lookup tables built one element at a time, and deep
+# recursion -- and compares the compile time of the AST-walking evaluator
+# with that of -fconstexpr-bytecode.
+#
+# Usage: constexpr-bytecode.py path/to/clang [--scale N]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+PRELUDE = '''
+constexpr bool is_prime(unsigned n) {
+  if (n < 2)
+    return false;
+  for (unsigned d = 2; d * d <= n; ++d)
+    if (n % d == 0)
+      return false;
+  return true;
+}
+
+constexpr unsigned count_primes(unsigned limit) {
+  unsigned count = 0;
+  for (unsigned i = 0; i < limit; ++i)
+    if (is_prime(i))
+      ++count;
+  return count;
+}
+
+constexpr unsigned crc_entry(unsigned n) {
+  unsigned c = n;
+  for (int k = 0; k < 8; ++k)
+    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+  return c;
+}
+
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+template <unsigned... I> struct seq {};
+template <unsigned N, unsigned... I>
+struct make_seq : make_seq<N - 1, N - 1, I...> {};
+template <unsigned... I> struct make_seq<0, I...> { typedef seq<I...> type; };
+
+template <unsigned Salt, unsigned... I>
+constexpr unsigned table_checksum(seq<I...>) {
+  unsigned sum = 0;
+  unsigned table[] = {crc_entry(I ^ Salt)...};
+  for (unsigned v : table)
+    sum ^= v;
+  return sum;
+}
+'''
+
+KINDS = {
+    'primes': lambda i, scale:
+        'static_assert(count_primes(%d) > 0, "");' % (scale * 1000 + i),
+    'table': lambda i, scale:
+        'static_assert(table_checksum<%d>(make_seq<256>::type()) || true, "");'
+        % i,
+    'recursion': lambda i, scale:
+        'static_assert(fib(%d) > 0, "");' % (14 + scale + i % 4),
+}
+
+def write_tu(path, kind, scale, count):
+  with open(path, 'w') as f:
+    print(PRELUDE, file=f)
+    for i in range(count):
+      print(KINDS[kind](i, scale), file=f)
+
+def run(clang, tu, extra):
+  args = [clang, '-cc1', '-std=c++14', '-fsyntax-only',
+          '-fconstexpr-steps', '100000000', tu] + extra
+  start = time.time()
+  p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  _, err = p.communicate()
+  elapsed = time.time() - start
+  if p.returncode != 0:
+    sys.stderr.write(err.decode('utf-8', 'replace'))
+    sys.exit('clang failed')
+  return elapsed, err.decode('utf-8', 'replace')
+
+def best_of(runs, clang, tu, extra):
+  return min(run(clang, tu, extra)[0] for _ in range(runs))
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Benchmark the constexpr bytecode interpreter.')
+  parser.add_argument('clang', help='path to the clang binary to benchmark')
+  parser.add_argument('--scale', type=int, default=4,
+                      help='size of each constant evaluation')
+  parser.add_argument('--count', type=int, default=50,
+                      help='number of constant evaluations per file')
+  parser.add_argument('--runs', type=int, default=3,
+                      help='number of timed runs')
+  args = parser.parse_args()
+
+  root = tempfile.mkdtemp(prefix='constexpr-bytecode-')
+  try:
+    print('%-10s %10s %10s %8s' % ('input', 'ast (s)', 'bytecode', 'speedup'))
+    for kind in sorted(KINDS):
+      tu = os.path.join(root, kind + '.cpp')
+      write_tu(tu, kind, args.scale, args.count)
+      walker = best_of(args.runs, args.clang, tu, [])
+      bytecode = best_of(args.runs, args.clang, tu, ['-fconstexpr-bytecode'])
+      print('%-10s %10.3f %10.3f %7.2fx' %
+            (kind, walker, bytecode, walker / bytecode))
+
+    _, stats = run(args.clang, tu, ['-fconstexpr-bytecode', '-print-stats'])
+    for line in stats.splitlines():
+      if 'bytecode' in line:
+        print(line.strip())
+  finally:
+    shutil.rmtree(root)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,138 @@
+#!/usr/bin/env python
+#===- mangling-throughput.py - Benchmark name mangling --------------------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates translation units whose symbols have long, deeply nested template
+# names -- expression templates, type lists and polymorphic class templates --
+# and compares the time taken to generate IR for them, with debug info and
+# TBAA metadata, with and without the cache of mangled type names
+# (-fno-mangled-name-cache).
+#
+# Usage: mangling-throughput.py path/to/clang [--depth N] [--count N]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+PRELUDE = '''
+namespace lib {
+namespace detail {
+template <typename... Ts> struct list {};
+template <typename L, typename R> struct pair { L l; R r; };
+template <typename T, unsigned N> struct tagged { T value; };
+}
+
+template <typename L, typename R> struct add {
+  L l; R r;
+  add(L l, R r) : l(l), r(r) {}
+  double eval(int i) const { return l.eval(i) + r.eval(i); }
+};
+template <typename L, typename R> struct mul {
+  L l; R r;
+  mul(L l, R r) : l(l), r(r) {}
+  double eval(int i) const { return l.eval(i) * r.eval(i); }
+};
+template <unsigned N> struct leaf {
+  double eval(int i) const { return i * N; }
+};
+template <typename L, typename R> add<L, R> operator+(L l, R r) {
+  return add<L, R>(l, r);
+}
+template <typename L, typename R> mul<L, R> operator*(L l, R r) {
+  return mul<L, R>(l, r);
+}
+
+template <typename T> struct node {
+  T payload;
+  virtual ~node() {}
+  virtual int visit(int x) { return x + sizeof(T); }
+};
+}
+'''
+
+def expression(i, depth):
+  expr = 'lib::leaf<%d>()' % i
+  for d in range(depth):
+    op = '+' if (i + d) % 2 else '*'
+    expr = '(%s %s lib::leaf<%d>())' % (expr, op, d)
+  return expr
+
+def type_list(i, depth):
+  ty = 'lib::detail::tagged<int, %d>' % i
+  for d in range(depth):
+    ty = 'lib::detail::pair<%s, lib::detail::list<char, %s, long> >' % (
+        ty, 'lib::detail::tagged<short, %d>' % d)
+  return ty
+
+KINDS = {
+    'expression-templates': lambda i, depth:
+        'double f%d(int x) { return %s.eval(x); }' % (i, expression(i, depth)),
+    'type-lists': lambda i, depth:
+        'int f%d(int x) { lib::node<%s> n; return n.visit(x); }'
+        % (i, type_list(i, depth)),
+}
+
+def write_tu(path, kind, depth, count):
+  with open(path, 'w') as f:
+    print(PRELUDE, file=f)
+    for i in range(count):
+      print(KINDS[kind](i, depth), file=f)
+
+def run(clang, tu, extra):
+  args = [clang, '-cc1', '-std=c++11', '-emit-llvm', '-o', os.devnull,
+          '-O1', '-disable-llvm-passes', '-debug-info-kind=limited',
+          tu] + extra
+  start = time.time()
+  p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  _, err = p.communicate()
+  elapsed = time.time() - start
+  if p.returncode != 0:
+    sys.stderr.write(err.decode('utf-8', 'replace'))
+    sys.exit('clang failed')
+  return elapsed
+
+def best_of(runs, clang, tu, extra):
+  return min(run(clang, tu, extra) for _ in range(runs))
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Benchmark the mangled type name cache.')
+  parser.add_argument('clang', help='path to the clang binary to benchmark')
+  parser.add_argument('--depth', type=int, default=12,
+                      help='nesting depth of the generated template names')
+  parser.add_argument('--count', type=int, default=300,
+                      help='number of functions per file')
+  parser.add_argument('--runs', type=int, default=3,
+                      help='number of timed runs')
+  args = parser.parse_args()
+
+  root = tempfile.mkdtemp(prefix='mangling-throughput-')
+  try:
+    print('%-22s %10s %10s %8s' % ('input', 'uncached', 'cached', 'speedup'))
+    for kind in sorted(KINDS):
+      tu = os.path.join(root, kind + '.cpp')
+      write_tu(tu, kind, args.depth, args.count)
+      uncached = best_of(args.runs, args.clang, tu,
+                         ['-fno-mangled-name-cache'])
+      cached = best_of(args.runs, args.clang, tu, [])
+      print('%-22s %10.3f %10.3f %7.2fx' %
+            (kind, uncached, cached, uncached / cached))
+  finally:
+    shutil.rmtree(root)
+
+if __name__ == '__main__':
+  main()
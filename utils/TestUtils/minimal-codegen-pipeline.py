@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+#===- minimal-codegen-pipeline.py - Benchmark -O0 code generation ---------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates translation units with many small functions -- the shape of a
+# typical debug build -- and compares the time taken to compile them to an
+# object file at -O0 with and without -fminimal-codegen-pipeline.
+#
+# Usage: minimal-codegen-pipeline.py path/to/clang [--functions N]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+KINDS = {
+    'c-leaf': ('c', lambda i:
+        'int f%d(int x) { return x * %d + (x >> 3); }' % (i, i)),
+    'c-calls': ('c', lambda i:
+        'int f%d(int x) { return x ? f%d(x - 1) + %d : 0; }'
+        % (i, max(i - 1, 0), i)),
+    'cxx-classes': ('cpp', lambda i:
+        'struct S%d { int v; S%d(int v) : v(v) {} int get() const { return v; }'
+        ' }; int f%d(int x) { S%d s(x); return s.get() + %d; }'
+        % (i, i, i, i, i)),
+}
+
+def write_tu(path, kind, count):
+  with open(path, 'w') as f:
+    if kind == 'c-calls':
+      for i in range(count):
+        print('int f%d(int x);' % i, file=f)
+    for i in range(count):
+      print(KINDS[kind][1](i), file=f)
+
+def run(clang, tu, extra):
+  args = [clang, '-cc1', '-triple', 'x86_64-unknown-linux-gnu', '-emit-obj',
+          '-O0', '-debug-info-kind=limited', '-o', os.devnull, tu] + extra
+  start = time.time()
+  p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  _, err = p.communicate()
+  elapsed = time.time() - start
+  if p.returncode != 0:
+    sys.stderr.write(err.decode('utf-8', 'replace'))
+    sys.exit('clang failed')
+  return elapsed
+
+def best_of(runs, clang, tu, extra):
+  return min(run(clang, tu, extra) for _ in range(runs))
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Benchmark the minimal -O0 code generation pipeline.')
+  parser.add_argument('clang', help='path to the clang binary to benchmark')
+  parser.add_argument('--functions', type=int, default=5000,
+                      help='number of functions per file')
+  parser.add_argument('--runs', type=int, default=3,
+                      help='number of timed runs')
+  args = parser.parse_args()
+
+  root = tempfile.mkdtemp(prefix='minimal-codegen-pipeline-')
+  try:
+    print('%-12s %10s %10s %8s' % ('input', 'full (s)', 'minimal', 'speedup'))
+    for kind in sorted(KINDS):
+      tu = os.path.join(root, kind + '.' + KINDS[kind][0])
+      write_tu(tu, kind, args.functions)
+      full = best_of(args.runs, args.clang, tu, [])
+      minimal = best_of(args.runs, args.clang, tu,
+                        ['-fminimal-codegen-pipeline'])
+      print('%-12s %10.3f %10.3f %7.2fx' % (kind, full, minimal,
+                                            full / minimal))
+  finally:
+    shutil.rmtree(root)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+#===- module-chain-lookup.py - Benchmark lookups into module chains -------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates a chain of C++ modules, each of which imports the previous one and
+# reopens the same namespace, and times name lookups into that namespace from
+# a translation unit importing the last module. Every module contributes its
+# own on-disk lookup table for the namespace, so most probes of most tables
+# miss; this is the case the per-table bloom filters are meant to speed up.
+#
+# Usage: module-chain-lookup.py path/to/clang [--modules N] [--lookups N]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+def write_modules(root, num_modules, decls_per_module):
+  with open(os.path.join(root, 'module.modulemap'), 'w') as f:
+    for i in range(num_modules):
+      print('module m%d { header "m%d.h" export * }' % (i, i), file=f)
+
+  for i in range(num_modules):
+    with open(os.path.join(root, 'm%d.h' % i), 'w') as f:
+      if i:
+        print('#include "m%d.h"' % (i - 1), file=f)
+      print('namespace ns {', file=f)
+      for j in range(decls_per_module):
+        print('  int f%d_%d(int);' % (i, j), file=f)
+      print('  struct S%d { int member%d; };' % (i, i), file=f)
+      print('}', file=f)
+
+def write_tu(path, num_modules, num_lookups):
+  with open(path, 'w') as f:
+    print('#include "m%d.h"' % (num_modules - 1), file=f)
+    # Each redeclaration check looks up a name that no module knows about.
+    print('namespace ns {', file=f)
+    for i in range(num_lookups):
+      print('  void local%d();' % i, file=f)
+    print('}', file=f)
+    # ... and each qualified reference finds a name in exactly one module.
+    print('int use() {', file=f)
+    print('  int r = 0;', file=f)
+    for i in range(num_lookups):
+      print('  r += ns::f%d_0(r);' % (i % num_modules), file=f)
+    print('  return r;', file=f)
+    print('}', file=f)
+
+def run(clang, root, tu, cache, extra):
+  args = [clang, '-cc1', '-std=c++11', '-fsyntax-only', '-fmodules',
+          '-fimplicit-module-maps', '-fmodules-cache-path=' + cache,
+          '-I', root, tu] + extra
+  start = time.time()
+  p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  _, err = p.communicate()
+  elapsed = time.time() - start
+  if p.returncode != 0:
+    sys.stderr.write(err.decode('utf-8', 'replace'))
+    sys.exit('clang failed')
+  return elapsed, err.decode('utf-8', 'replace')
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Benchmark name lookup into a long chain of modules.')
+  parser.add_argument('clang', help='path to the clang binary to benchmark')
+  parser.add_argument('--modules', type=int, default=128,
+                      help='length of the module chain')
+  parser.add_argument('--decls', type=int, default=64,
+                      help='declarations contributed by each module')
+  parser.add_argument('--lookups', type=int, default=20000,
+                      help='number of lookups performed by the main file')
+  parser.add_argument('--runs', type=int, default=5,
+                      help='number of timed runs')
+  args = parser.parse_args()
+
+  root = tempfile.mkdtemp(prefix='module-chain-')
+  try:
+    cache = os.path.join(root, 'cache')
+    tu = os.path.join(root, 'main.cpp')
+    write_modules(root, args.modules, args.decls)
+    write_tu(tu, args.modules, args.lookups)
+
+    # Build the module cache once; it is not part of the measurement.
+    run(args.clang, root, tu, cache, [])
+
+    times = []
+    for _ in range(args.runs):
+      elapsed, _ = run(args.clang, root, tu, cache, [])
+      times.append(elapsed)
+    _, stats = run(args.clang, root, tu, cache, ['-print-stats'])
+
+    times.sort()
+    print('modules: %d, lookups: %d' % (args.modules, 2 * args.lookups))
+    print('best: %.3fs  median: %.3fs' % (times[0], times[len(times) // 2]))
+    print('lookups/sec (best run): %.0f' % (2 * args.lookups / times[0]))
+    for line in stats.splitlines():
+      if 'declcontext' in line:
+        print(line.strip())
+  finally:
+    shutil.rmtree(root)
+
+if __name__ == '__main__':
+  main()
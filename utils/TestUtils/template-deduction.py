@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+#===- template-deduction.py - Benchmark repeated template deduction -------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates a translation unit that calls a handful of small function
+# templates (in the style of std::move, std::forward and range helpers) many
+# times with the same argument types, and reports the compile time together
+# with the number of template argument deductions that were answered from
+# Sema's cache of deduced specializations.
+#
+# Usage: template-deduction.py path/to/clang [--types N] [--calls N]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+PRELUDE = '''
+namespace lib {
+template <class T> struct remove_reference { typedef T type; };
+template <class T> struct remove_reference<T &> { typedef T type; };
+template <class T> struct remove_reference<T &&> { typedef T type; };
+
+template <class T>
+typename remove_reference<T>::type &&move(T &&t) {
+  return static_cast<typename remove_reference<T>::type &&>(t);
+}
+template <class T>
+T &&forward(typename remove_reference<T>::type &t) {
+  return static_cast<T &&>(t);
+}
+template <class C> auto begin(C &c) -> decltype(c.begin()) {
+  return c.begin();
+}
+template <class C> auto end(C &c) -> decltype(c.end()) { return c.end(); }
+template <class T, class U> void assign(T &t, U &&u) {
+  t = lib::forward<U>(u);
+}
+}
+'''
+
+def write_tu(path, num_types, num_calls):
+  with open(path, 'w') as f:
+    print(PRELUDE, file=f)
+    for i in range(num_types):
+      print('struct T%d { int *begin(); int *end(); };' % i, file=f)
+    for i in range(num_types):
+      print('void use%d(T%d &a, T%d &b) {' % (i, i, i), file=f)
+      for j in range(num_calls):
+        print('  lib::assign(a, lib::move(b));', file=f)
+        print('  for (int *p = lib::begin(a); p != lib::end(a); ++p) ;',
+              file=f)
+      print('}', file=f)
+
+def run(clang, tu, extra):
+  args = [clang, '-cc1', '-std=c++11', '-fsyntax-only', tu] + extra
+  start = time.time()
+  p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  _, err = p.communicate()
+  elapsed = time.time() - start
+  if p.returncode != 0:
+    sys.stderr.write(err.decode('utf-8', 'replace'))
+    sys.exit('clang failed')
+  return elapsed, err.decode('utf-8', 'replace')
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Benchmark repeated template argument deduction.')
+  parser.add_argument('clang', help='path to the clang binary to benchmark')
+  parser.add_argument('--types', type=int, default=200,
+                      help='number of distinct argument types')
+  parser.add_argument('--calls', type=int, default=50,
+                      help='number of calls per function and argument type')
+  parser.add_argument('--runs', type=int, default=5,
+                      help='number of timed runs')
+  args = parser.parse_args()
+
+  root = tempfile.mkdtemp(prefix='template-deduction-')
+  try:
+    tu = os.path.join(root, 'main.cpp')
+    write_tu(tu, args.types, args.calls)
+
+    times = []
+    for _ in range(args.runs):
+      elapsed, _ = run(args.clang, tu, [])
+      times.append(elapsed)
+    _, stats = run(args.clang, tu, ['-print-stats'])
+
+    times.sort()
+    print('types: %d, calls per function: %d' % (args.types, args.calls))
+    print('best: %.3fs  median: %.3fs' % (times[0], times[len(times) // 2]))
+    for line in stats.splitlines():
+      if 'template argument deductions' in line:
+        print(line.strip())
+  finally:
+    shutil.rmtree(root)
+
+if __name__ == '__main__':
+  main()
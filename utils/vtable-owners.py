@@ -0,0 +1,178 @@
+#!/usr/bin/env python
+#===- vtable-owners.py - Assign vtables to translation units --------------===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+#
+# Generates the file read by clang's -fvtable-owners option from a
+# compilation database.
+#
+# Each translation unit in compile_commands.json is compiled to LLVM IR with
+# its own command line. Every vtable that the translation unit emits as a
+# discardable (linkonce_odr) definition -- the vtables of classes without a
+# key function and of implicit template instantiations -- is then assigned
+# to one of the translation units that emits it. When the project is built
+# with -fvtable-owners=<output>, only that translation unit defines the
+# vtable, together with its VTT and type_info object, and the others refer
+# to it.
+#
+# A vtable is only given to a translation unit that is linked into the same
+# program or shared library (link unit) as the translation units that use
+# it. By default, every translation unit in the compilation database is
+# assumed to be linked into a single link unit. Otherwise, each link unit is
+# given with --link-unit SOURCES=OUTPUT. SOURCES is a file listing the
+# source files of the link unit, one per line, relative to the build
+# directory. The owners for the link unit are written to OUTPUT, and its
+# translation units are built with -fvtable-owners=OUTPUT. A source file may
+# only be part of one link unit, since it is compiled once for all of them.
+# Translation units that are not part of any link unit are ignored, and must
+# be built without -fvtable-owners.
+#
+# The output has to be regenerated when classes are added, removed or moved
+# between files, or when files move between link units.
+#
+# Usage: vtable-owners.py [-p build-dir] [--clang path/to/clang]
+#                         [-o output | --link-unit sources=output...]
+#
+#===------------------------------------------------------------------------===#
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+VTABLE_DEFINITION = re.compile(r'^@(_ZTV\S+) = linkonce_odr ')
+
+def get_ir_command(entry, clang):
+    if 'arguments' in entry:
+        args = list(entry['arguments'])
+    else:
+        args = shlex.split(entry['command'])
+    if clang:
+        args[0] = clang
+
+    # Drop the output file, the compilation mode and any previous vtable
+    # owners file, and print the IR instead.
+    result = [args[0]]
+    skip = False
+    for arg in args[1:]:
+        if skip:
+            skip = False
+        elif arg == '-o':
+            skip = True
+        elif arg in ('-c', '-S', '-E', '-emit-llvm') or \
+                arg.startswith('-fvtable-owners=') or \
+                (arg.startswith('-o') and arg != '-o'):
+            pass
+        else:
+            result.append(arg)
+    return result + ['-S', '-emit-llvm', '-o', '-']
+
+def get_emitted_vtables(entry, clang):
+    command = get_ir_command(entry, clang)
+    process = subprocess.Popen(command, cwd=entry['directory'],
+                               stdout=subprocess.PIPE,
+                               universal_newlines=True)
+    vtables = set()
+    for line in process.stdout:
+        match = VTABLE_DEFINITION.match(line)
+        if match:
+            vtables.add(match.group(1))
+    if process.wait() != 0:
+        sys.exit('error: failed to compile %s' % entry['file'])
+    return vtables
+
+def read_link_unit(build_dir, spec):
+    if '=' not in spec:
+        sys.exit('error: expected SOURCES=OUTPUT, got %s' % spec)
+    sources, output = spec.split('=', 1)
+    with open(sources) as f:
+        paths = [os.path.abspath(os.path.join(build_dir, line.strip()))
+                 for line in f if line.strip()]
+    return paths, output
+
+def assign_owners(paths, users):
+    # Give each vtable to the translation unit of the link unit that
+    # currently owns the fewest, so that no single one becomes a bottleneck.
+    members = set(paths)
+    owned = dict((path, 0) for path in paths)
+    owners = {}
+    for vtable in sorted(users):
+        candidates = [path for path in users[vtable] if path in members]
+        if not candidates:
+            continue
+        owner = min(candidates, key=lambda path: (owned[path], path))
+        owned[owner] += 1
+        owners[vtable] = owner
+    return owners
+
+def write_owners(output, owners):
+    out = sys.stdout if output == '-' else open(output, 'w')
+    out.write('# Generated by vtable-owners.py; do not edit.\n')
+    for vtable in sorted(owners):
+        out.write('%s %s\n' % (vtable, owners[vtable]))
+    if out is not sys.stdout:
+        out.close()
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Assign vtables to translation units for -fvtable-owners')
+    parser.add_argument('-p', dest='build_dir', default='.',
+                        help='directory containing compile_commands.json')
+    parser.add_argument('-o', dest='output', default='-',
+                        help='file to write the vtable owners to, when the '
+                             'whole database is one link unit')
+    parser.add_argument('--link-unit', dest='link_units', action='append',
+                        default=[], metavar='SOURCES=OUTPUT',
+                        help='write the vtable owners for the sources listed '
+                             'in SOURCES, which are linked together, to '
+                             'OUTPUT')
+    parser.add_argument('--clang',
+                        help='compiler to use instead of the one in the '
+                             'compilation database')
+    args = parser.parse_args()
+
+    with open(os.path.join(args.build_dir, 'compile_commands.json')) as f:
+        database = json.load(f)
+
+    # Visit the translation units in a fixed order, so that the output does
+    # not depend on the order of the compilation database.
+    entries = {}
+    for entry in database:
+        path = os.path.abspath(os.path.join(entry['directory'],
+                                            entry['file']))
+        entries[path] = entry
+
+    if args.link_units:
+        link_units = [read_link_unit(args.build_dir, spec)
+                      for spec in args.link_units]
+    else:
+        link_units = [(sorted(entries), args.output)]
+
+    unit_of = {}
+    for paths, output in link_units:
+        for path in paths:
+            if path not in entries:
+                sys.exit('error: %s is not in the compilation database' % path)
+            if unit_of.setdefault(path, output) != output:
+                sys.exit('error: %s is part of more than one link unit' % path)
+
+    users = {}
+    for path in sorted(unit_of):
+        for vtable in get_emitted_vtables(entries[path], args.clang):
+            users.setdefault(vtable, []).append(path)
+
+    for paths, output in link_units:
+        write_owners(output, assign_owners(sorted(paths), users))
+
+if __name__ == '__main__':
+    main()